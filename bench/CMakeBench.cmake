@@ -0,0 +1,24 @@
+# This file contains instructions to build the benchmark application using CMake.
+
+set(BENCH_EXE ArgsParserBench)
+add_executable(
+    ${BENCH_EXE}
+    bench/main.cpp
+    bench/async_validation.cpp
+    bench/batch.cpp
+    bench/bundled.cpp
+    bench/conversion.cpp
+    bench/copy.cpp
+    bench/help.cpp
+    bench/layered.cpp
+    bench/list_converter.cpp
+    bench/lookup.cpp
+    bench/parallel.cpp
+    bench/parse.cpp
+    bench/registration.cpp
+    bench/response_file.cpp
+    bench/static_parser.cpp
+    bench/typed_token.cpp
+    bench/value_access.cpp
+)
+target_link_libraries(${BENCH_EXE} ${LIB_NAME})
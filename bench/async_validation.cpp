@@ -0,0 +1,52 @@
+#include <chrono>
+#include <future>
+#include <thread>
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures validating values with a check that waits on I/O, standing in for
+// a file system or network access of a hundred microseconds, made by a
+// validator that blocks against one returning a future. The waits of the
+// latter overlap, so the parse should take little more than a single wait.
+void benchAsyncValidation(){
+    const size_t count = 64;
+    std::string suffix = "/" + std::to_string(count);
+    std::string blocking_name = "validation/blocking_io" + suffix;
+    std::string async_name = "validation/async_io" + suffix;
+    if (!Bench::selected(blocking_name) && !Bench::selected(async_name)) return;
+
+    const std::chrono::microseconds latency(100);
+    std::vector<std::string> line = {"tool", "--paths"};
+    for (size_t i = 0; i < count; i++) line.push_back("input-" + std::to_string(i) + ".txt");
+    std::vector<char*> argv;
+    for (size_t i = 0; i < line.size(); i++) argv.push_back(&line[i][0]);
+
+    double blocking = 0;
+    if (Bench::selected(blocking_name)) {
+        ArgsParser::Parser parser;
+        parser.registerOption("paths", {"--paths"}, "path", "", count, nullptr, [latency](const std::string& path){
+            std::this_thread::sleep_for(latency);
+            return !path.empty();
+        });
+        ArgsParser::CompiledSchema schema = parser.compile();
+        blocking = Bench::measure([&schema, &argv](){
+            Bench::doNotOptimize(schema.parse((int)argv.size(), argv.data()));
+        });
+        Bench::report(blocking_name, blocking, "per command line");
+    }
+
+    if (Bench::selected(async_name)) {
+        ArgsParser::Parser parser;
+        parser.registerOption("paths", {"--paths"}, "path", "", count, nullptr, [latency](const std::string& path){
+            return std::async(std::launch::async, [latency, &path](){
+                std::this_thread::sleep_for(latency);
+                return !path.empty();
+            });
+        });
+        ArgsParser::CompiledSchema schema = parser.compile();
+        double ns = Bench::measure([&schema, &argv](){
+            Bench::doNotOptimize(schema.parse((int)argv.size(), argv.data()));
+        });
+        Bench::report(async_name, ns, "per command line" + (blocking > 0? ", speedup " + std::to_string(blocking / ns) : ""));
+    }
+}
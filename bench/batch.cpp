@@ -0,0 +1,44 @@
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures the throughput of parseBatch as the number of threads grows, from
+// one thread up to one per hardware thread.
+void benchBatch(){
+    const size_t count = 20000;
+    std::string suffix = "/" + std::to_string(count);
+
+    ArgsParser::Parser parser;
+    for (size_t i = 0; i < 50; i++) {
+        parser.registerOption<int>(Bench::makeName(i), {"--" + Bench::makeName(i)}, "value", "An option.", 1,
+            nullptr, [](const std::string& value){ return std::stoi(value); });
+    }
+    parser.registerOption("files", {"--files"}, "file", "The files.", 8);
+    ArgsParser::CompiledSchema schema = parser.compile();
+
+    std::vector<std::vector<std::string>> lines(count);
+    for (size_t i = 0; i < count; i++) {
+        lines[i].push_back("tool");
+        for (size_t j = 0; j < 10; j++) {
+            lines[i].push_back("--" + Bench::makeName((i + j * 7) % 50));
+            lines[i].push_back(std::to_string(i + j));
+        }
+        lines[i].push_back("--files");
+        for (size_t j = 0; j < 4; j++) lines[i].push_back("input-" + std::to_string(j) + ".txt");
+    }
+
+    size_t hardware = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    double single_thread = 0;
+    for (size_t threads = 1; threads <= hardware; threads *= 2) {
+        std::string name = "batch/threads_" + std::to_string(threads) + suffix;
+        if (!Bench::selected(name)) continue;
+
+        ArgsParser::ThreadPool pool(threads);
+        double ns = Bench::measure([&schema, &lines, &pool](){
+            Bench::doNotOptimize(ArgsParser::parseBatch(schema, lines, pool));
+        }, count);
+        if (threads == 1) single_thread = ns;
+        Bench::report(name, ns, single_thread > 0? "speedup " + std::to_string(single_thread / ns) : "");
+
+        if (threads < hardware && threads * 2 > hardware) threads = hardware / 2;
+    }
+}
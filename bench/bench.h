@@ -0,0 +1,100 @@
+/**
+ * bench.h
+ * 
+ * This file contains a minimal benchmarking harness used by the ArgsParser
+ * benchmark application.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+namespace Bench
+{
+    /**
+     * This method returns whether a benchmark should run, that is, whether its
+     * name contains the filter passed in the command line (if any).
+     * 
+     * @param {std::string} name The name of the benchmark.
+     * @return {bool} Whether the benchmark is selected.
+     */
+    bool selected(const std::string& name);
+
+    /**
+     * This method prints the result of a benchmark.
+     * 
+     * @param {std::string} name The name of the benchmark.
+     * @param {double} ns_per_op The mean time of one operation in nanoseconds.
+     * @param {std::string} extra Additional information to print with the result.
+     */
+    void report(const std::string& name, double ns_per_op, const std::string& extra = "");
+
+    /**
+     * This method generates a unique identifier-safe string (letters only)
+     * for a given index.
+     * 
+     * @param {size_t} index The index to generate a name for.
+     * @return {std::string} The name.
+     */
+    std::string makeName(size_t index);
+
+    /**
+     * This method prevents the compiler from optimizing away the computation
+     * of a value.
+     */
+    template <typename T>
+    inline void doNotOptimize(const T& value){
+    #if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+    #else
+        static volatile const void* sink;
+        sink = &value;
+    #endif
+    }
+
+    /**
+     * This method calls a function repeatedly, doubling the number of calls
+     * until the run takes long enough to be measured reliably.
+     * 
+     * @param {F} function The function to measure.
+     * @param {size_t} operations The number of operations performed by each call.
+     * @return {double} The mean time of one operation in nanoseconds.
+     */
+    template <typename F>
+    double measure(F function, size_t operations = 1){
+        typedef std::chrono::steady_clock clock;
+        const std::chrono::nanoseconds minimum_time = std::chrono::milliseconds(200);
+
+        function();     // Warm up.
+        for (size_t iterations = 1;; iterations *= 2) {
+            clock::time_point start = clock::now();
+            for (size_t i = 0; i < iterations; i++) function();
+            std::chrono::nanoseconds elapsed = clock::now() - start;
+            if (elapsed >= minimum_time)
+                return (double)elapsed.count() / (double)(iterations * operations);
+        }
+    }
+}
+
+// Benchmark groups.
+void benchAsyncValidation();
+void benchBatch();
+void benchBundled();
+void benchConversion();
+void benchCopy();
+void benchHelp();
+void benchLayered();
+void benchListConverter();
+void benchLookup();
+void benchParallel();
+void benchParse();
+void benchResponseFile();
+void benchStaticParser();
+void benchRegistration();
+void benchTypedToken();
+void benchValueAccess();
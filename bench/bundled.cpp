@@ -0,0 +1,31 @@
+#include <argsparser.h>
+#include "bench.h"
+
+// Compares parsing a command line of bundled short switches and joined
+// values against the same arguments given one per argv entry.
+void benchBundled(){
+    ArgsParser::Parser parser;
+    const char switches[] = "abcdefgh";
+    for (size_t i = 0; switches[i] != '\0'; i++)
+        parser.registerSwitch(std::string("switch-") + switches[i], {std::string(1, switches[i])});
+    parser.registerOption("jobs", {"j", "jobs"});
+    parser.registerOption("level", {"l", "level"});
+    ArgsParser::CompiledSchema schema = parser.compile();
+    ArgsParser::ParseOptions options;
+    options.zero_copy = true;
+
+    std::vector<std::string> bundled = {"tool", "-abcdefghj16", "--level=12"};
+    std::vector<std::string> expanded = {"tool", "-a", "-b", "-c", "-d", "-e", "-f", "-g", "-h", "-j", "16", "--level", "12"};
+    const std::pair<std::string, std::vector<std::string>*> lines[] = {{"bundled", &bundled}, {"expanded", &expanded}};
+
+    for (const auto& line : lines) {
+        std::string name = "bundled/parse/" + line.first;
+        if (!Bench::selected(name)) continue;
+
+        std::vector<char*> argv;
+        for (size_t i = 0; i < line.second->size(); i++) argv.push_back(&(*line.second)[i][0]);
+        Bench::report(name, Bench::measure([&schema, &argv, &options](){
+            Bench::doNotOptimize(schema.parse((int)argv.size(), argv.data(), options));
+        }), "per command line");
+    }
+}
@@ -0,0 +1,70 @@
+#include <charconv>
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures the cost of rejecting invalid input, comparing converters and
+// validators that throw to those returning Expected and Status, which never
+// touch the unwinder, and to the built-in converter used when none is given.
+// Valid input is measured as a baseline.
+void benchConversion(){
+    const size_t count = 16;
+    std::string suffix = "/" + std::to_string(count);
+
+    ArgsParser::Converter<int> throwing_converter = [](const std::string& value){ return std::stoi(value); };
+    ArgsParser::Converter<int> checked_converter = [](std::string_view value) -> ArgsParser::Expected<int> {
+        int result = 0;
+        std::from_chars_result parsed = std::from_chars(value.data(), value.data() + value.size(), result);
+        if (parsed.ec != std::errc() || parsed.ptr != value.data() + value.size())
+            return ArgsParser::Failure("Invalid integer.");
+        return result;
+    };
+    ArgsParser::Validator<int> throwing_validator = [](const int& value) -> bool {
+        if (value > 1000) throw std::out_of_range("Value out of range.");
+        return true;
+    };
+    ArgsParser::Validator<int> false_validator = [](const int& value){ return value <= 1000; };
+    ArgsParser::Validator<int> checked_validator = [](const int& value){
+        return value <= 1000? ArgsParser::Status() : ArgsParser::Failure("Value out of range.");
+    };
+
+    struct Case{
+        std::string name;
+        ArgsParser::Converter<int> converter;
+        ArgsParser::Validator<int> validator;
+        std::string value;
+    };
+    std::vector<Case> cases = {
+        {"conversion/valid/throwing", throwing_converter, throwing_validator, "42"},
+        {"conversion/valid/checked", checked_converter, checked_validator, "42"},
+        {"conversion/valid/default", nullptr, nullptr, "42"},
+        {"conversion/bad_input/throwing", throwing_converter, nullptr, "xx"},
+        {"conversion/bad_input/checked", checked_converter, nullptr, "xx"},
+        {"conversion/bad_input/default", nullptr, nullptr, "xx"},
+        {"conversion/rejected/throwing", checked_converter, throwing_validator, "4242"},
+        {"conversion/rejected/bool", checked_converter, false_validator, "4242"},
+        {"conversion/rejected/checked", checked_converter, checked_validator, "4242"},
+    };
+
+    for (size_t c = 0; c < cases.size(); c++) {
+        std::string name = cases[c].name + suffix;
+        if (!Bench::selected(name)) continue;
+
+        ArgsParser::Parser parser;
+        std::vector<std::string> line = {"tool"};
+        for (size_t i = 0; i < count; i++) {
+            parser.registerOption<int>(Bench::makeName(i), {"--" + Bench::makeName(i)}, "value", "An option.", 1,
+                nullptr, cases[c].converter, cases[c].validator);
+            line.push_back("--" + Bench::makeName(i));
+            line.push_back(cases[c].value);
+        }
+        ArgsParser::CompiledSchema schema = parser.compile();
+        std::vector<char*> argv;
+        for (size_t i = 0; i < line.size(); i++) argv.push_back(&line[i][0]);
+
+        ArgsParser::ParseOptions options;
+        options.zero_copy = true;
+        Bench::report(name, Bench::measure([&schema, &argv, &options](){
+            Bench::doNotOptimize(schema.parse((int)argv.size(), argv.data(), options));
+        }, count), "per value");
+    }
+}
@@ -0,0 +1,28 @@
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures copying a parser holding many arguments, as done to give each
+// request its own parser from a template, and the cost of the first
+// registration on the copy, which copies the shared arguments.
+void benchCopy(){
+    const size_t count = 4000;
+    std::string suffix = "/" + std::to_string(count);
+
+    ArgsParser::Parser parser;
+    for (size_t i = 0; i < count; i++)
+        parser.registerOption(Bench::makeName(i), {"--" + Bench::makeName(i)}, "value", "An option.");
+
+    if (Bench::selected("copy/parser" + suffix)) {
+        Bench::report("copy/parser" + suffix, Bench::measure([&parser](){
+            ArgsParser::Parser copy(parser);
+            Bench::doNotOptimize(copy);
+        }), "per copy");
+    }
+
+    if (Bench::selected("copy/parser_then_register" + suffix)) {
+        Bench::report("copy/parser_then_register" + suffix, Bench::measure([&parser](){
+            ArgsParser::Parser copy(parser);
+            Bench::doNotOptimize(copy.registerSwitch("extra", {"extra"}));
+        }), "per copy");
+    }
+}
@@ -0,0 +1,33 @@
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures rendering the usage text of a parser, and reading it once it has
+// been cached.
+void benchHelp(){
+    const size_t count = 200;
+    std::string suffix = "/" + std::to_string(count);
+    if (!Bench::selected("help/render" + suffix) && !Bench::selected("help/cached" + suffix)) return;
+
+    ArgsParser::Parser parser;
+    parser.setProgramName("tool");
+    for (size_t i = 0; i < count; i++) {
+        if (i % 2 == 0) parser.registerSwitch(Bench::makeName(i), {"--" + Bench::makeName(i)}, "Enables a feature of the tool which needs a description long enough to wrap.");
+        else parser.registerOption(Bench::makeName(i), {"--" + Bench::makeName(i)}, "value", "Sets a value.");
+    }
+
+    // The text is cached for a single width, so alternating widths renders
+    // it on every call.
+    if (Bench::selected("help/render" + suffix)) {
+        size_t width = 80;
+        Bench::report("help/render" + suffix, Bench::measure([&parser, &width](){
+            width = width == 80? 100 : 80;
+            Bench::doNotOptimize(parser.getHelpText(width));
+        }), "per render");
+    }
+
+    if (Bench::selected("help/cached" + suffix)) {
+        Bench::report("help/cached" + suffix, Bench::measure([&parser](){
+            Bench::doNotOptimize(parser.getHelpText(80));
+        }), "per read");
+    }
+}
@@ -0,0 +1,48 @@
+#include <cstdio>
+#include <fstream>
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures parsing a command line against a schema whose options all have a
+// key in a configuration file, reading one of them, against reading all of
+// them. Options that are never read should not cost a lookup.
+void benchLayered(){
+    const size_t count = 1000;
+    std::string suffix = "/" + std::to_string(count);
+    if (!Bench::selected("layered/read_one" + suffix) && !Bench::selected("layered/read_all" + suffix)) return;
+
+    const char* path = "bench_layered.ini";
+    {
+        std::ofstream file(path);
+        file << "[service]\n";
+        for (size_t i = 0; i < count; i++) file << Bench::makeName(i) << " = " << i << "\n";
+    }
+
+    ArgsParser::Parser parser;
+    std::vector<ArgsParser::Token> tokens;
+    for (size_t i = 0; i < count; i++) {
+        tokens.push_back(parser.registerOption<int>(Bench::makeName(i), {"--" + Bench::makeName(i)}));
+        parser.setConfigKey(tokens.back(), "service." + Bench::makeName(i));
+    }
+    ArgsParser::CompiledSchema schema = parser.compile();
+
+    std::vector<char*> argv = {(char*)"tool"};
+    ArgsParser::ParseOptions options;
+    options.config_file = path;
+
+    if (Bench::selected("layered/read_one" + suffix)) {
+        Bench::report("layered/read_one" + suffix, Bench::measure([&schema, &argv, &options, &tokens](){
+            ArgsParser::ParseResult result = schema.parse(1, argv.data(), options);
+            Bench::doNotOptimize((int)result.getValue<int>(tokens[0]));
+        }), "per command line");
+    }
+
+    if (Bench::selected("layered/read_all" + suffix)) {
+        Bench::report("layered/read_all" + suffix, Bench::measure([&schema, &argv, &options, &tokens](){
+            ArgsParser::ParseResult result = schema.parse(1, argv.data(), options);
+            for (size_t i = 0; i < tokens.size(); i++) Bench::doNotOptimize((int)result.getValue<int>(tokens[i]));
+        }), "per command line");
+    }
+
+    std::remove(path);
+}
@@ -0,0 +1,80 @@
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures the throughput of ListConverter on a long comma-separated list of
+// integers, against splitting the list and converting each element with
+// std::stoll, as user code had to before, and with std::from_chars.
+void benchListConverter(){
+    const size_t count = 1000000;
+    std::string suffix = "/" + std::to_string(count);
+
+    // Shard ids of mixed lengths, from 1 to 12 digits.
+    std::string list;
+    unsigned long long seed = 88172645463325252ull;
+    for (size_t i = 0; i < count; i++) {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        if (i != 0) list += ',';
+        list += std::to_string(seed % 1000000000000ull >> (seed % 37));
+    }
+    std::string size = "    " + std::to_string(list.size() >> 20) + " MiB";
+    auto throughput = [&list](double ns){
+        return std::to_string(list.size() / ns) + " GB/s";
+    };
+
+    if (Bench::selected("list/list_converter" + suffix)) {
+        ArgsParser::ListConverter<long long> converter;
+        std::pmr::vector<long long> values;
+        double ns = Bench::measure([&converter, &list, &values](){
+            values.clear();
+            Bench::doNotOptimize(converter(list, values));
+        });
+        Bench::report("list/list_converter" + suffix, ns / count, throughput(ns) + size);
+    }
+
+    if (Bench::selected("list/split_stoll" + suffix)) {
+        std::vector<long long> values;
+        double ns = Bench::measure([&list, &values](){
+            values.clear();
+            size_t begin = 0;
+            for (;;) {
+                size_t end = list.find(',', begin);
+                values.push_back(std::stoll(list.substr(begin, end - begin)));
+                if (end == std::string::npos) break;
+                begin = end + 1;
+            }
+            Bench::doNotOptimize(values.data());
+        });
+        Bench::report("list/split_stoll" + suffix, ns / count, throughput(ns));
+    }
+
+    if (Bench::selected("list/split_from_chars" + suffix)) {
+        std::vector<long long> values;
+        double ns = Bench::measure([&list, &values](){
+            values.clear();
+            const char* begin = list.data();
+            const char* end = begin + list.size();
+            while (begin < end) {
+                long long value;
+                std::from_chars_result result = std::from_chars(begin, end, value);
+                values.push_back(value);
+                begin = result.ptr + 1;
+            }
+            Bench::doNotOptimize(values.data());
+        });
+        Bench::report("list/split_from_chars" + suffix, ns / count, throughput(ns));
+    }
+
+    // The same list parsed as an option, including the copy of argv.
+    if (Bench::selected("list/parse" + suffix)) {
+        ArgsParser::Parser parser;
+        parser.registerOption<long long>("ids", {"--ids"}, "ids", "The shard ids.", 1, nullptr,
+            ArgsParser::ListConverter<long long>());
+        ArgsParser::CompiledSchema schema = parser.compile();
+        std::string tool = "tool", option = "--ids";
+        std::vector<char*> argv = {&tool[0], &option[0], &list[0]};
+        double ns = Bench::measure([&schema, &argv](){
+            Bench::doNotOptimize(schema.parse((int)argv.size(), argv.data()));
+        });
+        Bench::report("list/parse" + suffix, ns / count, throughput(ns));
+    }
+}
@@ -0,0 +1,89 @@
+#include <argsparser.h>
+#include "bench.h"
+
+// Compares resolving argv entries through the compiled perfect hash table
+// against the registration-time path (identifier check plus map lookup), and
+// measures resolving abbreviations and suggesting identifiers through the
+// identifier trie.
+void benchLookup(){
+    const size_t counts[] = {10, 1000, 50000};
+    for (size_t count : counts) {
+        std::string suffix = "/" + std::to_string(count);
+        if (!Bench::selected("lookup/perfect_hash" + suffix) && !Bench::selected("lookup/map" + suffix)) continue;
+
+        // Compiling freezes the schema, after which the parser also looks
+        // identifiers up in the perfect hash table. The map is measured on a
+        // parser that is never compiled.
+        ArgsParser::Parser parser;
+        ArgsParser::Parser compiled;
+        for (size_t i = 0; i < count; i++) {
+            parser.registerSwitch(Bench::makeName(i), {"--" + Bench::makeName(i)});
+            compiled.registerSwitch(Bench::makeName(i), {"--" + Bench::makeName(i)});
+        }
+        ArgsParser::CompiledSchema schema = compiled.compile();
+
+        // Probe every registered identifier plus as many misses.
+        std::vector<std::string> probes;
+        for (size_t i = 0; i < count; i++) {
+            probes.push_back("--" + Bench::makeName(i));
+            probes.push_back("--" + Bench::makeName(i + count));
+        }
+        std::vector<const char*> argv;
+        for (size_t i = 0; i < probes.size(); i++) argv.push_back(probes[i].c_str());
+
+        if (Bench::selected("lookup/perfect_hash" + suffix)) {
+            double ns = Bench::measure([&schema, &argv](){
+                for (size_t i = 0; i < argv.size(); i++)
+                    Bench::doNotOptimize(schema.isIdentifierRegistered(argv[i]));
+            }, argv.size());
+            Bench::report("lookup/perfect_hash" + suffix, ns);
+        }
+
+        if (Bench::selected("lookup/map" + suffix)) {
+            double ns = Bench::measure([&parser, &argv](){
+                for (size_t i = 0; i < argv.size(); i++)
+                    Bench::doNotOptimize(parser.isIdentifierRegistered(std::string(argv[i])));
+            }, argv.size());
+            Bench::report("lookup/map" + suffix, ns);
+        }
+    }
+
+    const size_t trie_counts[] = {1000, 20000};
+    for (size_t count : trie_counts) {
+        std::string suffix = "/" + std::to_string(count);
+        if (!Bench::selected("lookup/abbreviation" + suffix) && !Bench::selected("lookup/suggestion" + suffix)) continue;
+
+        ArgsParser::Parser parser;
+        for (size_t i = 0; i < count; i++) {
+            parser.registerSwitch(Bench::makeName(i), {"--" + Bench::makeName(i) + "option"});
+        }
+        ArgsParser::CompiledSchema schema = parser.compile();
+
+        // Abbreviations drop the end of the identifier, and typos swap two
+        // of its characters.
+        std::vector<std::string> abbreviations;
+        std::vector<std::string> typos;
+        for (size_t i = 0; i < count; i++) {
+            std::string identifier = "--" + Bench::makeName(i) + "option";
+            abbreviations.push_back(identifier.substr(0, identifier.size() - 3));
+            std::swap(identifier[identifier.size() - 2], identifier[identifier.size() - 3]);
+            typos.push_back(identifier);
+        }
+
+        if (Bench::selected("lookup/abbreviation" + suffix)) {
+            double ns = Bench::measure([&schema, &abbreviations](){
+                for (size_t i = 0; i < abbreviations.size(); i++)
+                    Bench::doNotOptimize(schema.matchIdentifier(abbreviations[i]));
+            }, abbreviations.size());
+            Bench::report("lookup/abbreviation" + suffix, ns);
+        }
+
+        if (Bench::selected("lookup/suggestion" + suffix)) {
+            double ns = Bench::measure([&schema, &typos](){
+                for (size_t i = 0; i < typos.size(); i++)
+                    Bench::doNotOptimize(schema.suggestIdentifiers(typos[i], 1, 1));
+            }, typos.size());
+            Bench::report("lookup/suggestion" + suffix, ns);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <cstdio>
+#include "bench.h"
+
+namespace Bench
+{
+    static std::string filter;
+
+    bool selected(const std::string& name){
+        return name.find(filter) != std::string::npos;
+    }
+
+    // Whether results are written as JSON, and how many have been so far.
+    static bool json = false;
+    static size_t reported = 0;
+
+    // Returns a string quoted for JSON.
+    static std::string quote(const std::string& string){
+        std::string quoted = "\"";
+        for (char character : string) {
+            if (character == '"' || character == '\\') quoted += '\\';
+            quoted += character;
+        }
+        return quoted + "\"";
+    }
+
+    void report(const std::string& name, double ns_per_op, const std::string& extra){
+        char buffer[64];
+        if (json) {
+            std::snprintf(buffer, sizeof(buffer), "%.2f", ns_per_op);
+            std::cout << (reported++ == 0? "\n" : ",\n") << "    {\"name\": " << quote(name) << ", \"ns_per_op\": " << buffer
+                      << ", \"note\": " << quote(extra) << "}" << std::flush;
+            return;
+        }
+        std::snprintf(buffer, sizeof(buffer), "%12.2f ns/op", ns_per_op);
+        std::cout << name << std::string(name.size() < 48? 48 - name.size() : 1, ' ') << buffer;
+        if (extra != "") std::cout << "    " << extra;
+        std::cout << std::endl;
+    }
+
+    std::string makeName(size_t index){
+        std::string name;
+        do {
+            name += (char)('a' + index % 26);
+            index /= 26;
+        } while (index > 0);
+        return "id-" + name;
+    }
+}
+
+int main(int argc, char* argv[]){
+    // An optional argument filters the benchmarks to run by name, and
+    // --json writes the results as a JSON document instead of a table.
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--json") Bench::json = true;
+        else Bench::filter = argv[i];
+    }
+    if (Bench::json) std::cout << "{\"benchmarks\": [" << std::flush;
+
+    benchAsyncValidation();
+    benchBatch();
+    benchBundled();
+    benchConversion();
+    benchCopy();
+    benchHelp();
+    benchLayered();
+    benchListConverter();
+    benchLookup();
+    benchParallel();
+    benchParse();
+    benchRegistration();
+    benchResponseFile();
+    benchStaticParser();
+    benchTypedToken();
+    benchValueAccess();
+
+    if (Bench::json) std::cout << (Bench::reported > 0? "\n" : "") << "]}" << std::endl;
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures post-processing a command line on a thread pool against doing so
+// on the parsing thread, for an option taking many values alongside a few
+// single value options. Cheap validators show the cost of splitting the work,
+// and slow ones the speedup it buys.
+void benchParallel(){
+    const size_t count = 20000;
+    std::string suffix = "/" + std::to_string(count);
+    const char* modes[] = {"cheap", "slow"};
+
+    size_t hardware = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    ArgsParser::ThreadPool pool(hardware);
+
+    for (size_t mode = 0; mode < 2; mode++) {
+        std::string sequential_name = std::string("parallel/sequential_") + modes[mode] + suffix;
+        std::string pool_name = std::string("parallel/pool_") + modes[mode] + suffix;
+        if (!Bench::selected(sequential_name) && !Bench::selected(pool_name)) continue;
+
+        // The slow validator stands in for a check such as a lookup or a
+        // file system access, taking around a microsecond.
+        const size_t rounds = mode == 0? 0 : 1000;
+        auto validator = [rounds](const int& value){
+            unsigned hash = (unsigned)value;
+            for (size_t i = 0; i < rounds; i++) hash = hash * 2654435761u + 1;
+            Bench::doNotOptimize(hash);
+            return value >= 0;
+        };
+
+        ArgsParser::Parser parser;
+        for (size_t i = 0; i < 20; i++)
+            parser.registerOption<int>(Bench::makeName(i), {"--" + Bench::makeName(i)}, "value", "", 1, nullptr, nullptr, validator);
+        parser.registerOption<int>("values", {"--values"}, "value", "", count, nullptr, nullptr, validator);
+        ArgsParser::CompiledSchema schema = parser.compile();
+
+        std::vector<std::string> line = {"tool"};
+        for (size_t i = 0; i < 20; i++) {
+            line.push_back("--" + Bench::makeName(i));
+            line.push_back(std::to_string(i + 10));
+        }
+        line.push_back("--values");
+        for (size_t i = 0; i < count; i++) line.push_back(std::to_string(i + 10));
+        std::vector<char*> argv;
+        for (size_t i = 0; i < line.size(); i++) argv.push_back(&line[i][0]);
+
+        double sequential = 0;
+        if (Bench::selected(sequential_name)) {
+            ArgsParser::ParseOptions options;
+            options.zero_copy = true;
+            sequential = Bench::measure([&schema, &argv, &options](){
+                Bench::doNotOptimize(schema.parse((int)argv.size(), argv.data(), options));
+            }, count);
+            Bench::report(sequential_name, sequential, "per value");
+        }
+
+        if (Bench::selected(pool_name)) {
+            ArgsParser::ParseOptions options;
+            options.zero_copy = true;
+            options.pool = &pool;
+            double ns = Bench::measure([&schema, &argv, &options](){
+                Bench::doNotOptimize(schema.parse((int)argv.size(), argv.data(), options));
+            }, count);
+            Bench::report(pool_name, ns, std::to_string(hardware) + " threads" + (sequential > 0? ", speedup " + std::to_string(sequential / ns) : ""));
+        }
+    }
+}
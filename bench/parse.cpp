@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <limits>
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures the throughput of parsing synthetic command lines of 10 to 100k
+// tokens, made mostly of switches, of options followed by a value, or of
+// positionals, against a compiled schema.
+void benchParse(){
+    const size_t counts[] = {10, 1000, 100000};
+    const std::string kinds[] = {"switches", "options", "positionals"};
+    const size_t registered = 1000;
+
+    for (const std::string& kind : kinds) {
+        for (size_t count : counts) {
+            // Token positions are 16 bits wide, which bounds the number of
+            // positionals that can be registered.
+            if (kind == "positionals") count = std::min<size_t>(count, 50000);
+            std::string name = "parse/" + kind + "/" + std::to_string(count);
+            if (!Bench::selected(name)) continue;
+
+            // Every positional reads a single token, so there is one per
+            // token. Switches and options are repeated through the line.
+            ArgsParser::Parser parser;
+            std::vector<std::string> line = {"tool"};
+            if (kind == "switches") {
+                for (size_t i = 0; i < registered; i++) parser.registerSwitch(Bench::makeName(i), {"--" + Bench::makeName(i)});
+                for (size_t i = 0; i < count; i++) line.push_back("--" + Bench::makeName(i % registered));
+            }
+            else if (kind == "options") {
+                for (size_t i = 0; i < registered; i++)
+                    parser.registerOption(Bench::makeName(i), {"--" + Bench::makeName(i)}, "value", "", std::numeric_limits<size_t>::max());
+                for (size_t i = 0; i + 1 < count; i += 2) {
+                    line.push_back("--" + Bench::makeName((i / 2) % registered));
+                    line.push_back("value-" + std::to_string(i));
+                }
+            }
+            else {
+                for (size_t i = 0; i < count; i++) parser.registerPositional(Bench::makeName(i), "value");
+                for (size_t i = 0; i < count; i++) line.push_back("value-" + std::to_string(i));
+            }
+            ArgsParser::CompiledSchema schema = parser.compile();
+
+            std::vector<char*> argv;
+            for (size_t i = 0; i < line.size(); i++) argv.push_back(&line[i][0]);
+            ArgsParser::ParseOptions options;
+            options.zero_copy = true;
+
+            size_t tokens = line.size() - 1;
+            double ns = Bench::measure([&schema, &argv, &options](){
+                Bench::doNotOptimize(schema.parse((int)argv.size(), argv.data(), options));
+            }, tokens);
+            Bench::report(name, ns, "per token");
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#include <memory_resource>
+#include <argsparser.h>
+#include "bench.h"
+
+// Compares registering and releasing a parser with the default allocator
+// against a parser backed by a monotonic arena, and registering one argument
+// at a time against registering the whole batch through registerMany.
+void benchRegistration(){
+    const size_t count = 4000;
+    std::string suffix = "/" + std::to_string(count);
+
+    std::vector<std::string> names;
+    std::vector<std::vector<std::string>> identifiers;
+    for (size_t i = 0; i < count; i++) {
+        names.push_back(Bench::makeName(i));
+        identifiers.push_back({"--" + Bench::makeName(i)});
+    }
+
+    if (Bench::selected("registration/heap" + suffix)) {
+        double ns = Bench::measure([&names, &identifiers](){
+            ArgsParser::Parser parser;
+            for (size_t i = 0; i < names.size(); i++)
+                parser.registerOption(names[i], identifiers[i], "value", "An option.");
+            Bench::doNotOptimize(parser);
+        }, count);
+        Bench::report("registration/heap" + suffix, ns);
+    }
+
+    if (Bench::selected("registration/arena" + suffix)) {
+        // The buffer is sized once, so every run after the first one is
+        // served from memory that is already mapped.
+        std::vector<char> buffer(4 * 1024 * 1024);
+        double ns = Bench::measure([&names, &identifiers, &buffer](){
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            ArgsParser::Parser parser(&arena);
+            for (size_t i = 0; i < names.size(); i++)
+                parser.registerOption(names[i], identifiers[i], "value", "An option.");
+            Bench::doNotOptimize(parser);
+        }, count);
+        Bench::report("registration/arena" + suffix, ns);
+    }
+
+    if (Bench::selected("registration/many" + suffix)) {
+        std::vector<ArgsParser::ArgumentSpec> specs(count);
+        for (size_t i = 0; i < count; i++) {
+            specs[i].type = ArgsParser::ArgType::Option;
+            specs[i].name = names[i];
+            specs[i].identifiers = identifiers[i];
+            specs[i].description = "An option.";
+        }
+        double ns = Bench::measure([&specs](){
+            ArgsParser::Parser parser;
+            Bench::doNotOptimize(parser.registerMany(specs));
+        }, count);
+        Bench::report("registration/many" + suffix, ns);
+    }
+}
\ No newline at end of file
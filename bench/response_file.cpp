@@ -0,0 +1,46 @@
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures the expansion of a large response file, holding a single option
+// followed by a million file names, a few of them quoted or escaped.
+void benchResponseFile(){
+    const size_t count = 1000000;
+    std::string name = "response_file/expand/" + std::to_string(count);
+    if (!Bench::selected(name)) return;
+
+    const char* path = "bench_response_file.rsp";
+    size_t bytes = 0;
+    {
+        std::ofstream file(path);
+        std::string line = "--files\n";
+        file << line;
+        bytes += line.size();
+        for (size_t i = 0; i < count; i++) {
+            if (i % 100 == 0) line = "\"src/dir " + std::to_string(i) + "/file.cpp\"\n";
+            else if (i % 100 == 1) line = "src/dir\\ " + std::to_string(i) + "/file.cpp\n";
+            else line = "src/dir/file_" + std::to_string(i) + ".cpp\n";
+            file << line;
+            bytes += line.size();
+        }
+    }
+
+    ArgsParser::Parser parser;
+    parser.registerOption("files", {"--files"}, "file", "The files.", std::numeric_limits<size_t>::max());
+    ArgsParser::CompiledSchema schema = parser.compile();
+
+    std::string response = std::string("@") + path;
+    std::vector<char*> argv = {(char*)"tool", &response[0], nullptr};
+    ArgsParser::ParseOptions options;
+    options.expand_response_files = true;
+
+    double ns = Bench::measure([&schema, &argv, &options](){
+        ArgsParser::ParseResult result = schema.parse(2, argv.data(), options);
+        Bench::doNotOptimize(result.getValueView("files").size());
+    }, count);
+    Bench::report(name, ns, std::to_string((double)bytes / (ns * count)) + " GB/s");
+
+    std::remove(path);
+}
@@ -0,0 +1,54 @@
+#include <argsparser.h>
+#include "bench.h"
+
+static constexpr ArgsParser::StaticArgument static_arguments[] = {
+    ArgsParser::staticSwitch("verbose", {"v", "verbose"}),
+    ArgsParser::staticSwitch("quiet", {"q", "quiet"}),
+    ArgsParser::staticOption("jobs", {"j", "jobs"}),
+    ArgsParser::staticOption("include", {"I", "include"}, 4),
+    ArgsParser::staticOption("output", {"o", "output"}),
+    ArgsParser::staticPositional("input"),
+};
+
+// Compares a parser generated at compile time with a runtime schema holding
+// the same arguments, both when parsing and when starting up, that is,
+// registering the arguments and compiling the schema.
+void benchStaticParser(){
+    typedef ArgsParser::StaticParser<static_arguments> StaticTool;
+
+    std::vector<std::string> line = {"tool", "-v", "--jobs", "16", "-I", "src", "include", "--output", "out.bin", "main.cpp"};
+    std::vector<char*> argv;
+    for (size_t i = 0; i < line.size(); i++) argv.push_back(&line[i][0]);
+
+    auto make_parser = [](){
+        ArgsParser::Parser parser;
+        parser.registerSwitch("verbose", {"v", "verbose"});
+        parser.registerSwitch("quiet", {"q", "quiet"});
+        parser.registerOption("jobs", {"j", "jobs"});
+        parser.registerOption("include", {"I", "include"}, "path", "", 4);
+        parser.registerOption("output", {"o", "output"});
+        parser.registerPositional("input", "input");
+        return parser;
+    };
+
+    if (Bench::selected("static_parser/startup/runtime")) {
+        Bench::report("static_parser/startup/runtime", Bench::measure([&make_parser](){
+            Bench::doNotOptimize(make_parser().compile());
+        }), "per schema");
+    }
+
+    if (Bench::selected("static_parser/parse/runtime")) {
+        ArgsParser::CompiledSchema schema = make_parser().compile();
+        ArgsParser::ParseOptions options;
+        options.zero_copy = true;
+        Bench::report("static_parser/parse/runtime", Bench::measure([&schema, &argv, &options](){
+            Bench::doNotOptimize(schema.parse((int)argv.size(), argv.data(), options));
+        }), "per command line");
+    }
+
+    if (Bench::selected("static_parser/parse/static")) {
+        Bench::report("static_parser/parse/static", Bench::measure([&argv](){
+            Bench::doNotOptimize(StaticTool::parse((int)argv.size(), argv.data()));
+        }), "per command line");
+    }
+}
@@ -0,0 +1,45 @@
+#include <argsparser.h>
+#include "bench.h"
+
+// Compares reading a typed value by name, which hashes the name and checks the
+// type of the state at run time, by Token, which only checks the type, and by
+// TypedToken, which does neither.
+void benchTypedToken(){
+    const size_t count = 1000;
+    std::string suffix = "/" + std::to_string(count);
+    if (!Bench::selected("typed_token/name" + suffix) && !Bench::selected("typed_token/token" + suffix) &&
+        !Bench::selected("typed_token/typed" + suffix)) return;
+
+    ArgsParser::Parser parser;
+    std::vector<ArgsParser::TypedToken<int>> tokens;
+    std::vector<std::string> names;
+    std::vector<std::string> line = {"tool"};
+    for (size_t i = 0; i < count; i++) {
+        names.push_back(Bench::makeName(i));
+        tokens.push_back(parser.registerOption<int>(names[i], {"--" + names[i]}));
+        line.push_back("--" + names[i]);
+        line.push_back(std::to_string(i + 10));
+    }
+    std::vector<char*> argv;
+    for (size_t i = 0; i < line.size(); i++) argv.push_back(&line[i][0]);
+    ArgsParser::ParseResult result = parser.compile().parse((int)argv.size(), argv.data());
+
+    if (Bench::selected("typed_token/name" + suffix)) {
+        Bench::report("typed_token/name" + suffix, Bench::measure([&result, &names](){
+            for (size_t i = 0; i < names.size(); i++) Bench::doNotOptimize(result.getValueView<int>(names[i]).front());
+        }, count), "per read");
+    }
+
+    if (Bench::selected("typed_token/token" + suffix)) {
+        std::vector<ArgsParser::Token> plain_tokens(tokens.begin(), tokens.end());
+        Bench::report("typed_token/token" + suffix, Bench::measure([&result, &plain_tokens](){
+            for (size_t i = 0; i < plain_tokens.size(); i++) Bench::doNotOptimize(result.getValueView<int>(plain_tokens[i]).front());
+        }, count), "per read");
+    }
+
+    if (Bench::selected("typed_token/typed" + suffix)) {
+        Bench::report("typed_token/typed" + suffix, Bench::measure([&result, &tokens](){
+            for (size_t i = 0; i < tokens.size(); i++) Bench::doNotOptimize(result.getValueView(tokens[i]).front());
+        }, count), "per read");
+    }
+}
@@ -0,0 +1,37 @@
+#include <argsparser.h>
+#include "bench.h"
+
+// Measures reading an option holding many values, comparing the wrappers
+// returned by getValue, which copy every value, to the views returned by
+// getValueView, which refer to the values stored in the parse result.
+void benchValueAccess(){
+    const size_t counts[] = {10, 1000};
+    for (size_t count : counts) {
+        std::string suffix = "/" + std::to_string(count);
+        if (!Bench::selected("value_access/copy" + suffix) && !Bench::selected("value_access/view" + suffix)) continue;
+
+        ArgsParser::Parser parser;
+        parser.registerOption<std::string>("include", {"--include"}, "path", "Include paths.", count);
+        std::vector<std::string> line = {"tool", "--include"};
+        for (size_t i = 0; i < count; i++) line.push_back("src/include/" + Bench::makeName(i));
+        std::vector<char*> argv;
+        for (size_t i = 0; i < line.size(); i++) argv.push_back(&line[i][0]);
+        parser.parse((int)argv.size(), argv.data());
+
+        if (Bench::selected("value_access/copy" + suffix)) {
+            double ns = Bench::measure([&parser](){
+                std::vector<std::string> values = parser.getValue<std::string>("include");
+                Bench::doNotOptimize(values.back());
+            });
+            Bench::report("value_access/copy" + suffix, ns, "per read");
+        }
+
+        if (Bench::selected("value_access/view" + suffix)) {
+            double ns = Bench::measure([&parser](){
+                ArgsParser::Span<std::string> values = parser.getValueView<std::string>("include");
+                Bench::doNotOptimize(values.back());
+            });
+            Bench::report("value_access/view" + suffix, ns, "per read");
+        }
+    }
+}
@@ -17,12 +17,13 @@ int main(int argc, char* argv[]){
     myParser.registerSwitch("switch", {"-s", "--switch"}, "Prints a 'Hello World!' when called.", helloWorld);
 
     // Register a positional that takes an integer and checks if it is less than a value using lambda expressions.
+    // Integers are converted by the built-in converter, so none is passed.
     int value = 1000;
     myParser.registerPositional<int>(
         "positional",
         "integer",
         [&myParser](){ std::cout << "Entered value " << std::to_string((int)myParser.getValue<int>("positional")) << std::endl; },
-        [](const std::string& str)->int{ return std::stoi(str); },
+        nullptr,
         [value](const int& i)->bool{ bool valid = i < value ? true : false; return valid; },
         [](const std::exception& e){ std::cout << e.what(); }
     );
@@ -9,10 +9,18 @@
 #pragma once
 
 #include <argsparser/autohelp.h>
+#include <argsparser/batch.h>
 #include <argsparser/common.h>
 #include <argsparser/container.h>
+#include <argsparser/converters.h>
+#include <argsparser/expected.h>
 #include <argsparser/input_container.h>
+#include <argsparser/list_converter.h>
+#include <argsparser/parse_result.h>
 #include <argsparser/parser.h>
+#include <argsparser/schema.h>
+#include <argsparser/static_parser.h>
+#include <argsparser/thread_pool.h>
 #include <argsparser/typed_input_container.h>
 #include <argsparser/value_wrapper.h>
 #include <argsparser/version.hpp>
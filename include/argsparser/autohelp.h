@@ -15,9 +15,9 @@
 namespace ArgsParser
 {
     /**
-     * This method outputs usage help text to the provided stream (which is
-     * the standard output stream "std::cout" by default) in the following
-     * form:
+     * These methods output usage help text to the provided stream (which is
+     * the standard output stream "std::cout" by default) or file descriptor
+     * in the following form:
      *      usage: ${program_name} [<positional>] ... [<args>]
      *          -s, --switch                        ${switch_description}
      *          ...
@@ -26,6 +26,20 @@ namespace ArgsParser
      *          -o, --option                        ${option_description}
      *          -p, --value-option <placeholder>    ${value_option_description}
      *          ...
+     * 
+     * The text is taken from the cache of the parser (see
+     * Parser::getHelpText) and written at once, with a single write() when a
+     * file descriptor is given. Descriptions are wrapped to the width given,
+     * or else to the width of the terminal the file descriptor or
+     * "std::cout" refers to. Other streams are wrapped to 80 columns. Unlike
+     * the "help" switch registered by enableAutohelp, these methods do not
+     * exit the program.
+     * 
+     * @param {Parser} parser The parser to describe.
+     * @param {std::ostream|int} The stream or file descriptor to write to.
+     * @param {size_t} width The number of columns to wrap to, or 0 to pick it from the stream.
      */
-    void autohelper(const Parser& parser, std::ostream& stream = std::cout);
-}
\ No newline at end of file
+    void autohelper(const Parser& parser, std::ostream& stream = std::cout, size_t width = 0);
+    void autohelper(const Parser* parser, std::ostream& stream = std::cout, size_t width = 0);
+    void autohelper(const Parser& parser, int fd);
+}
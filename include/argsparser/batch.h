@@ -0,0 +1,65 @@
+/**
+ * batch.h
+ * 
+ * This file contains the declaration of the batch parsing interface, used to
+ * parse many command lines against the same schema in parallel.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <argsparser/parse_result.h>
+#include <argsparser/thread_pool.h>
+
+namespace ArgsParser
+{
+    /**
+     * This struct stores the outcome of parsing one command line of a batch.
+     * If parsing failed, the result is empty and the error describes the
+     * failure.
+     */
+    struct BatchResult
+    {
+        // Whether the line was parsed without error.
+        bool success;
+
+        // The description of the error, if parsing failed.
+        std::string error;
+
+        // The state of every argument found in the line.
+        ParseResult result;
+    };
+
+    /**
+     * These methods parse a list of command lines against a schema, spreading
+     * the lines over the threads of a pool. Each line is a full command line,
+     * starting with the program name, as argv would be.
+     * 
+     * Results are returned in the order of the lines, whatever order they are
+     * parsed in. Callbacks of the schema run on the threads of the pool, so
+     * they must be safe to call concurrently. For the same reason, every
+     * line allocates its result from options.resource at the same time, so
+     * a resource given there must be thread safe, such as a
+     * std::pmr::synchronized_pool_resource. A monotonic_buffer_resource is
+     * not. Without one, each result is allocated from the default resource.
+     * 
+     * @param {CompiledSchema} schema The schema to parse the lines against.
+     * @param {vector<vector<string>>} lines The command lines to parse.
+     * @param {size_t|ThreadPool} threads The number of threads to use (0 for one per hardware thread), or the pool to run on.
+     * @param {ParseOptions} options The settings to parse every line with.
+     * @return {vector<BatchResult>} The result of each line.
+     */
+    std::vector<BatchResult> parseBatch(
+        const CompiledSchema& schema,
+        const std::vector<std::vector<std::string>>& lines,
+        size_t threads = 0,
+        const ParseOptions& options = ParseOptions()
+    );
+    std::vector<BatchResult> parseBatch(
+        const CompiledSchema& schema,
+        const std::vector<std::vector<std::string>>& lines,
+        ThreadPool& pool,
+        const ParseOptions& options = ParseOptions()
+    );
+}
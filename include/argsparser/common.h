@@ -13,7 +13,12 @@
 #include <vector>
 #include <exception>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
+#include <argsparser/expected.h>
 
 namespace ArgsParser
 {
@@ -29,25 +34,173 @@ namespace ArgsParser
         Option
     };
 
+    namespace Detail
+    {
+        template <typename Void, typename R, typename F, typename... Args>
+        struct ReturnsImpl : std::false_type {};
+
+        template <typename R, typename F, typename... Args>
+        struct ReturnsImpl<std::enable_if_t<std::is_same_v<std::invoke_result_t<F, Args...>, R>>, R, F, Args...> : std::true_type {};
+
+        // Whether calling F with Args returns exactly R.
+        template <typename R, typename F, typename... Args>
+        using Returns = ReturnsImpl<void, R, F, Args...>;
+
+        // Whether F can be stored as a validator or converter, as opposed to
+        // being one already or a null pointer.
+        template <typename F, typename Self>
+        constexpr bool is_function_v =
+            !std::is_same_v<std::decay_t<F>, Self> && !std::is_same_v<std::decay_t<F>, std::nullptr_t>;
+
+        // Returns the result of an asynchronous validation once it is ready.
+        // Exceptions stored in the future are reported as failures, as are
+        // those thrown by validators returning a boolean.
+        inline Status awaitStatus(std::future<Status>& result){
+            try {
+                return result.get();
+            }
+            catch (const std::exception& e) {
+                return Failure(e.what());
+            }
+        }
+
+        // Returns a future holding a status that is already known.
+        inline std::future<Status> readyStatus(Status status){
+            std::promise<Status> promise;
+            promise.set_value(std::move(status));
+            return promise.get_future();
+        }
+
+        // Whether a function object is empty.
+        template <typename F>
+        bool isEmpty(const F& function) noexcept{
+            if constexpr (std::is_constructible_v<bool, const F&>) return !static_cast<bool>(function);
+            else return false;
+        }
+    }
+
     /**
      * This is the declaration of a validator function.
      * 
-     * Validator functions must always take a string (the input that will be 
-     * fed into it) and return a boolean of whether the validation succeeded 
-     * or not. 
+     * Validator functions must always take the input that will be fed into it
+     * and return whether the validation succeeded or not, either as a boolean
+     * or as a Status that also describes the failure.
      * 
      * The result of the validation process can be retrieved by calling 
      * getValidation() on the container or through the equivalent interface 
      * on the parser itself.
      * 
-     * Optionally, validator functions may throw an exception with the error 
-     * that caused validation to fail. The exception will be handled internally
-     * and the error message made available if validation failures are not to 
-     * be considered critical. Otherwise it will be rethrown.
+     * Optionally, validator functions returning a boolean may throw an
+     * exception with the error that caused validation to fail. The exception
+     * will be handled internally and the error message made available if
+     * validation failures are not to be considered critical. Validators that
+     * return a Status report failures without throwing, which is much cheaper
+     * when invalid input is common.
+     * 
+     * Validators that wait on I/O, such as checking that a file exists or a
+     * port is free, may instead return a std::future of a bool or a Status.
+     * Such validators are started for every value before any is awaited, so
+     * that their waits overlap, and are awaited in the order of the values
+     * before any callback is called. The value passed remains valid until
+     * the future is ready.
      * 
      * Some sample validator methods are defined in samples/validators.h
      */
-    template <typename T> using Validator = std::function<bool(const T&)>;
+    template <typename T>
+    class Validator{
+        public:
+            Validator(std::nullptr_t = nullptr) noexcept {};
+
+            /**
+             * This constructor stores a validator function, taking a const T&
+             * and returning either a bool or a Status, or a future of either.
+             * 
+             * @param {F} function The validator function.
+             */
+            template <typename F, typename = std::enable_if_t<Detail::is_function_v<F, Validator<T>>>>
+            Validator(F function){
+                if (Detail::isEmpty(function)) return;
+                if constexpr (Detail::Returns<Status, F&, const T&>::value) {
+                    function_ = std::move(function);
+                }
+                else if constexpr (Detail::Returns<std::future<Status>, F&, const T&>::value) {
+                    async_function_ = [function](const T& input) mutable -> std::future<Status> {
+                        try {
+                            return function(input);
+                        }
+                        catch (const std::exception& e) {
+                            return Detail::readyStatus(Failure(e.what()));
+                        }
+                    };
+                }
+                else if constexpr (Detail::Returns<std::future<bool>, F&, const T&>::value) {
+                    async_function_ = [function](const T& input) mutable -> std::future<Status> {
+                        try {
+                            // The result is translated by the thread awaiting it.
+                            return std::async(std::launch::deferred, [result = function(input)]() mutable -> Status {
+                                if (result.get()) return Status();
+                                return Failure("Unspecified validation error.");
+                            });
+                        }
+                        catch (const std::exception& e) {
+                            return Detail::readyStatus(Failure(e.what()));
+                        }
+                    };
+                }
+                else {
+                    static_assert(std::is_invocable_r_v<bool, F&, const T&>, "A validator must return bool, Status or a future of either.");
+                    function_ = [function](const T& input) mutable -> Status {
+                        try {
+                            if (function(input)) return Status();
+                        }
+                        catch (const std::exception& e) {
+                            return Failure(e.what());
+                        }
+                        return Failure("Unspecified validation error.");
+                    };
+                }
+            };
+
+            /**
+             * This method validates a value.
+             * 
+             * @param {T} input The value to validate.
+             * @return {Status} The result of the validation.
+             */
+            Status operator()(const T& input) const {
+                if (!async_function_) return function_(input);
+                std::future<Status> result = async_function_(input);
+                return Detail::awaitStatus(result);
+            };
+
+            /**
+             * This method starts validating a value. Asynchronous validators
+             * return as soon as they have started, while others validate the
+             * value before returning.
+             * 
+             * @param {T} input The value to validate, which must remain valid until the result is ready.
+             * @return {future<Status>} The result of the validation.
+             */
+            std::future<Status> start(const T& input) const {
+                if (!async_function_) return Detail::readyStatus(function_(input));
+                return async_function_(input);
+            };
+
+            /**
+             * This method returns whether the validator returns a future.
+             * 
+             * @return {bool} Whether the validator is asynchronous.
+             */
+            bool isAsync() const noexcept { return static_cast<bool>(async_function_); };
+
+            explicit operator bool() const noexcept { return function_ || async_function_; };
+            bool operator==(std::nullptr_t) const noexcept { return !function_ && !async_function_; };
+            bool operator!=(std::nullptr_t) const noexcept { return function_ || async_function_; };
+
+        private:
+            std::function<Status(const T&)> function_;
+            std::function<std::future<Status>(const T&)> async_function_;
+    };
 
     /**
      * This is the declaration of a callback function. 
@@ -74,9 +227,100 @@ namespace ArgsParser
      * This is the declaration of a converter function.
      * 
      * Converter functions are used to convert input from user submitted strings
-     * to another type. As such, they must always take a string and a pointer.
-     * The string will be the user input string, and the pointer will be an
-     * argument of the template instantiated type to contain the result.
+     * to another type. They either take a string and return the converted
+     * value, throwing an exception if the input is invalid, or take a
+     * string_view and return an Expected<T> holding either the value or the
+     * failure. The latter never throws, so invalid input costs no more to
+     * reject than valid input costs to convert.
+     * 
+     * A converter may also turn a single input into any number of values, such
+     * as a comma-separated list (see ListConverter). Such converters take a
+     * string_view and the vector of converted values, append to it and return
+     * a Status.
      */
-    template <typename T> using Converter = std::function<T(const std::string&)>;
+    template <typename T>
+    class Converter{
+        public:
+            Converter(std::nullptr_t = nullptr) noexcept {};
+
+            /**
+             * This constructor stores a converter function, taking a string
+             * and returning T, taking a string or string_view and returning
+             * Expected<T>, or taking a string_view and a pmr::vector<T> and
+             * returning Status.
+             * 
+             * @param {F} function The converter function.
+             */
+            template <typename F, typename = std::enable_if_t<Detail::is_function_v<F, Converter<T>>>>
+            Converter(F function){
+                if (Detail::isEmpty(function)) return;
+                if constexpr (Detail::Returns<Status, F&, std::string_view, std::pmr::vector<T>&>::value) {
+                    list_function_ = std::move(function);
+                }
+                else if constexpr (Detail::Returns<Expected<T>, F&, std::string_view>::value) {
+                    function_ = std::move(function);
+                }
+                else if constexpr (Detail::Returns<Expected<T>, F&, const std::string&>::value) {
+                    function_ = [function](std::string_view input) mutable {
+                        return function(std::string(input));
+                    };
+                }
+                else {
+                    static_assert(std::is_invocable_r_v<T, F&, const std::string&>, "A converter must return T or Expected<T>.");
+                    function_ = [function](std::string_view input) mutable -> Expected<T> {
+                        try {
+                            return function(std::string(input));
+                        }
+                        catch (const std::exception& e) {
+                            return Failure(e.what());
+                        }
+                    };
+                }
+            };
+
+            /**
+             * This method converts user input to a single value. A converter
+             * producing lists only succeeds if the input holds exactly one
+             * value.
+             * 
+             * @param {std::string_view} input The user input.
+             * @return {Expected<T>} The converted value, or the reason the input is invalid.
+             */
+            Expected<T> operator()(std::string_view input) const{
+                if (!list_function_) return function_(input);
+
+                std::pmr::vector<T> values;
+                Status status = list_function_(input, values);
+                if (!status) return Failure(status.error());
+                if (values.size() != 1) return Failure("Expected a single value.");
+                return std::move(values[0]);
+            };
+
+            /**
+             * This method converts user input, appending every value it holds
+             * to a vector.
+             * 
+             * @param {std::string_view} input The user input.
+             * @param {pmr::vector<T>} output The vector to append the converted values to.
+             * @return {Status} Whether the conversion succeeded, and the reason if it did not.
+             */
+            Status operator()(std::string_view input, std::pmr::vector<T>& output) const{
+                if (list_function_) return list_function_(input, output);
+
+                Expected<T> value = function_(input);
+                if (!value) return Failure(value.error());
+                output.push_back(std::move(value.value()));
+                return Status();
+            };
+
+            explicit operator bool() const noexcept { return function_ || list_function_; };
+            bool operator==(std::nullptr_t) const noexcept { return !function_ && !list_function_; };
+            bool operator!=(std::nullptr_t) const noexcept { return function_ || list_function_; };
+
+        private:
+            // Only one of these is set, depending on whether the converter
+            // produces a single value or a list of values.
+            std::function<Expected<T>(std::string_view)> function_;
+            std::function<Status(std::string_view, std::pmr::vector<T>&)> list_function_;
+    };
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+/**
+ * config_file.h
+ *
+ * This file contains the declaration of the ConfigFile class, used to read
+ * the values of arguments from an INI style configuration file.
+ *
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <argsparser/mapped_file.h>
+#include <argsparser/span.h>
+
+namespace ArgsParser
+{
+    /**
+     * This class reads a configuration file made of "key = value" lines.
+     * Lines starting with '#' or ';' are comments, and a "[section]" line
+     * prefixes the keys that follow it, so that "jobs" under "[build]" is
+     * found as "build.jobs". A key given before any section may contain dots,
+     * and is found as is if no section matches. Whitespace around keys and
+     * values is ignored, and a value may be surrounded by single or double
+     * quotes to keep it. A key given several times has every value, in the
+     * order they appear.
+     *
+     * The file is mapped into memory, and is only read the first time a key
+     * is looked up. Keys and values refer to the mapping directly, so they
+     * are never copied.
+     */
+    class ConfigFile{
+        public:
+            /**
+             * Constructor of the configuration file.
+             *
+             * @param {std::string} path The path of the file.
+             * @except {std::runtime_error} The file could not be opened or mapped.
+             */
+            explicit ConfigFile(const std::string& path);
+            ConfigFile(const ConfigFile& other) = delete;
+            ConfigFile& operator=(const ConfigFile& other) = delete;
+
+            /**
+             * This method returns the values of a key. The file is read on the
+             * first call, which may be made from several threads at once.
+             *
+             * @param {std::string_view} key The key, prefixed by its section and a dot if it is in one.
+             * @return {Span<std::string_view>} The values of the key, in the order they appear. Empty if it is not in the file.
+             */
+            Span<std::string_view> find(std::string_view key) const;
+
+        private:
+            struct Entry{
+                std::string_view section;
+                std::string_view key;
+            };
+
+            MappedFile file_;
+            const char* data_;
+
+            // The entries of the file, sorted by section and key, and their
+            // values at the same positions.
+            mutable std::once_flag read_;
+            mutable std::vector<Entry> entries_;
+            mutable std::vector<std::string_view> values_;
+
+            void read() const;
+    };
+}
@@ -12,9 +12,53 @@
 #include <algorithm>
 #include <argsparser/value_wrapper.h>
 #include <argsparser/common.h>
+#include <argsparser/instrumentation.h>
+#include <argsparser/memory.h>
 
 namespace ArgsParser
 {
+    /**
+     * This struct stores the state of a container during a single parse. It
+     * is created by the container the first time the parser finds it in the
+     * command line and is owned by the ParseResult, which allows the container
+     * itself to remain immutable and be shared between parses.
+     */
+    struct ContainerState
+    {
+        // Whether the parser found the container in the command line.
+        bool active;
+
+        // The memory resource this state and its values are allocated from.
+        std::pmr::memory_resource* resource;
+
+        explicit ContainerState(std::pmr::memory_resource* resource = nullptr);
+        ContainerState(const ContainerState& other, std::pmr::memory_resource* resource);
+        virtual ~ContainerState();
+
+        /**
+         * Cloning method. The clone is allocated from the same memory resource
+         * as this object.
+         * 
+         * @return {ContainerState*} A pointer to a new ContainerState object cloned from this object.
+         */
+        virtual ContainerState* clone() const;
+
+        /**
+         * This method destroys this state and returns its memory to the
+         * resource it was allocated from.
+         */
+        virtual void destroy() noexcept;
+    };
+
+    /**
+     * This deleter releases a ContainerState through its destroy method, so
+     * that states can be held by unique_ptr regardless of their resource.
+     */
+    struct StateDeleter
+    {
+        void operator()(ContainerState* state) const noexcept { state->destroy(); };
+    };
+
     /**
      * This template base class is used to store basic information about an
      * argument type to be parsed.
@@ -52,15 +96,6 @@ namespace ArgsParser
              */
             std::vector<std::string> getIdentifiers() const noexcept;
 
-            /**
-             * This method retrieves whether this container is active. This is
-             * always false before parsing, and will be set if this container
-             * refers to an option called by the user.
-             * 
-             * @return {bool} Whether the parser found this container in the command line.
-             */
-            bool isActive() const noexcept;
-
             /**
              * Constructor of the container class.
              * 
@@ -69,52 +104,133 @@ namespace ArgsParser
              * @param {vector<string>} identifiers The list of identifiers associated with the argument.
              * @param {string} description The description of the argument.
              * @param {Callback} callback The method to call during post processing if this argument is found by the parser.
+             * @param {memory_resource*} resource The memory resource to allocate the strings of the container from.
              */
             Container(
                 const ArgType type,
                 const std::string& name,
                 const std::vector<std::string>& identifiers,
                 const std::string& description,
-                const Callback& callback
+                const Callback& callback,
+                std::pmr::memory_resource* resource = nullptr
             );
 
+            /**
+             * Constructor of the container class taking identifiers that are
+             * already normalized. They are moved into the container when
+             * allocated from the same memory resource, and copied otherwise.
+             */
+            Container(
+                const ArgType type,
+                const std::string& name,
+                std::pmr::vector<std::pmr::string>&& identifiers,
+                const std::string& description,
+                const Callback& callback,
+                std::pmr::memory_resource* resource = nullptr
+            );
+
+            /**
+             * Copy constructor of the container class. The strings of the
+             * container are copied into the memory resource provided.
+             * 
+             * @param {Container} other The container to copy.
+             * @param {memory_resource*} resource The memory resource to allocate the strings of the container from.
+             */
+            Container(const Container& other, std::pmr::memory_resource* resource);
+
             /**
              * Destructor of the container class.
              */
             virtual ~Container(); 
 
             /**
-             * Cloning method.
+             * Cloning method. Containers are allocated from a memory resource
+             * and must be released through destroy().
              * 
+             * @param {memory_resource*} resource The resource to allocate the clone from. Defaults to the resource of this object.
              * @return {Container*} A pointer to a new Container object cloned from this object.
              */
-            virtual Container* clone() const;
+            virtual Container* clone(std::pmr::memory_resource* resource = nullptr) const;
+
+            /**
+             * This method destroys this container and returns its memory to the
+             * resource it was allocated from.
+             */
+            virtual void destroy() noexcept;
+
+            /**
+             * This method retrieves the memory resource this container was
+             * allocated from.
+             * 
+             * @return {memory_resource*} The memory resource of this container.
+             */
+            std::pmr::memory_resource* getMemoryResource() const noexcept;
+
+            /**
+             * This method creates an empty parse state for this container.
+             * 
+             * @param {memory_resource*} resource The resource to allocate the state and its values from.
+             * @return {ContainerState*} A pointer to a new state object matching the type of this container.
+             */
+            virtual ContainerState* createState(std::pmr::memory_resource* resource = nullptr) const;
 
         protected:
-            const std::string name_;
-            const std::string description_;
-            const std::vector<std::string> identifiers_;
+            const std::pmr::string name_;
+            const std::pmr::string description_;
+            const std::pmr::vector<std::pmr::string> identifiers_;
             const Callback callback_;
             const ArgType type_;
 
-            bool active_;
-
-            friend class Parser;
+            friend struct SchemaImpl;
 
             /**
-             * This method sets the container to active. 
+             * This method sets a parse state of this container to active.
              * It is private, and can only be called by the parser. It will be
              * called if the parser finds this argument in the command line.
+             * 
+             * @param {ContainerState} state The parse state to update.
              */
-            void setActive();
+            void setActive(ContainerState& state) const;
 
             /**
-             * This method executes all post-processing logic associated with 
+             * This method executes all post-processing logic associated with
              * this container.
              * It is virtual, as the derived classes use different post-processing
-             * logic to account for features such as validation or conversion. 
+             * logic to account for features such as validation or conversion.
+             * 
+             * @param {ContainerState} state The parse state created by this container.
+             */
+            virtual void postProcess(ContainerState& state) const;
+
+            /**
+             * These methods split post-processing so that it may run in
+             * parallel. prepare splits the input of a state into parts of at
+             * most part_size inputs and returns how many there are, process
+             * converts and validates a single part, and complete gathers the
+             * parts and calls the callback or error callback.
+             * 
+             * Different parts of a state may be processed at once from
+             * different threads, but prepare and complete are only called from
+             * the thread parsing. A container without input has no parts, and
+             * only calls its callback once complete.
+             * 
+             * @param {ContainerState} state The parse state created by this container.
+             * @param {size_t} part_size The largest number of inputs in a part.
+             * @param {size_t} part The index of the part to process.
+             * @return {size_t} The number of parts the input was split into.
+             */
+            virtual size_t prepare(ContainerState& state, size_t part_size) const;
+            virtual void process(ContainerState& state, size_t part) const;
+            virtual void complete(ContainerState& state) const;
+
+            /**
+             * This method returns whether the validator of this container
+             * returns a future, in which case the parser starts validating
+             * every argument before awaiting any. See Validator.
+             * 
+             * @return {bool} Whether the container has an asynchronous validator.
              */
-            virtual void postProcess();
+            virtual bool hasAsyncValidator() const noexcept;
 
     };
 }
\ No newline at end of file
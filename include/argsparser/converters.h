@@ -0,0 +1,66 @@
+/**
+ * converters.h
+ * 
+ * This file contains the converters used by typed arguments registered
+ * without a converter of their own.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <argsparser/common.h>
+
+namespace ArgsParser
+{
+    /**
+     * This method converts user input to a number using std::from_chars. It
+     * does not depend on the locale, allocate or throw on invalid input.
+     * 
+     * The whole input must be a number: leading whitespace, a leading '+'
+     * and trailing characters are rejected, as are values that do not fit
+     * in T.
+     * 
+     * @param {std::string_view} input The user input.
+     * @return {Expected<T>} The number, or the reason the input is invalid.
+     */
+    template <typename T>
+    Expected<T> convertNumber(std::string_view input){
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "convertNumber requires a numeric type.");
+
+        T value{};
+        const char* end = input.data() + input.size();
+        std::from_chars_result result = std::from_chars(input.data(), end, value);
+        if (result.ec == std::errc::result_out_of_range)
+            return Failure("Value \"" + std::string(input) + "\" is out of range.");
+        if (result.ec != std::errc() || result.ptr != end || input.empty())
+            return Failure("Value \"" + std::string(input) + "\" is not a valid number.");
+        return value;
+    }
+
+    /**
+     * This method returns the converter used by typed arguments of type T
+     * registered without one. Numeric types are converted by convertNumber
+     * and strings are stored as is. Other types have no default converter,
+     * and a converter must be provided for their values to be stored.
+     * 
+     * @return {Converter<T>} The default converter, or an empty converter if there is none.
+     */
+    template <typename T>
+    Converter<T> defaultConverter(){
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            return Converter<T>(&convertNumber<T>);
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            return Converter<T>([](std::string_view input) -> Expected<std::string> { return std::string(input); });
+        }
+        else {
+            return nullptr;
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * expected.h
+ * 
+ * This file contains the declaration of the Expected and Status classes, used
+ * by converters and validators to report a failure without throwing.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace ArgsParser
+{
+    /**
+     * This struct describes why a conversion or validation failed. It is
+     * returned in place of a value to report the failure.
+     */
+    struct Failure{
+        std::string reason;
+
+        explicit Failure(std::string reason = "") : reason(std::move(reason)) {};
+    };
+
+    /**
+     * This class holds either the result of a conversion or the failure that
+     * prevented it. Converters may return it instead of throwing, so that
+     * invalid input is rejected without unwinding the stack.
+     * 
+     * Usage example:
+     *      Expected<int> toPort(std::string_view input) {
+     *          int port = 0;
+     *          ...
+     *          if (port > 65535) return Failure("Port out of range.");
+     *          return port;
+     *      }
+     */
+    template <typename T>
+    class Expected{
+        public:
+            template <
+                typename U = T,
+                typename = std::enable_if_t<
+                    std::is_convertible_v<U&&, T> &&
+                    !std::is_same_v<std::decay_t<U>, Failure> &&
+                    !std::is_same_v<std::decay_t<U>, Expected<T>>>
+            >
+            Expected(U&& value) : storage_(std::in_place_index<0>, std::forward<U>(value)) {};
+            Expected(Failure failure) : storage_(std::in_place_index<1>, std::move(failure)) {};
+
+            /**
+             * This method returns whether this holds a value.
+             * 
+             * @return {bool} True if this holds a value. False if it holds a failure.
+             */
+            bool hasValue() const noexcept { return storage_.index() == 0; };
+            explicit operator bool() const noexcept { return hasValue(); };
+
+            /**
+             * This method returns the value held. It must only be called if
+             * hasValue() returns true.
+             * 
+             * @return {T} The value.
+             */
+            T& value() noexcept { return *std::get_if<0>(&storage_); };
+            const T& value() const noexcept { return *std::get_if<0>(&storage_); };
+
+            /**
+             * This method returns the reason of the failure held. It must only
+             * be called if hasValue() returns false.
+             * 
+             * @return {std::string} The reason of the failure.
+             */
+            const std::string& error() const noexcept { return std::get_if<1>(&storage_)->reason; };
+
+        private:
+            std::variant<T, Failure> storage_;
+    };
+
+    /**
+     * This specialization holds only whether an operation succeeded, and the
+     * failure if it did not. Validators may return it instead of a boolean to
+     * describe why a value was rejected without throwing.
+     */
+    template <>
+    class Expected<void>{
+        public:
+            Expected() : failed_(false) {};
+            Expected(Failure failure) : failed_(true), reason_(std::move(failure.reason)) {};
+
+            bool hasValue() const noexcept { return !failed_; };
+            explicit operator bool() const noexcept { return hasValue(); };
+
+            const std::string& error() const noexcept { return reason_; };
+
+        private:
+            bool failed_;
+            std::string reason_;
+    };
+
+    using Status = Expected<void>;
+}
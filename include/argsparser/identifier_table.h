@@ -0,0 +1,127 @@
+/**
+ * identifier_table.h
+ * 
+ * This file contains the declaration of the IdentifierTable class, a read-only
+ * perfect hash table used to resolve command line identifiers to tokens.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <argsparser/memory.h>
+#include <argsparser/token.h>
+
+namespace ArgsParser
+{
+    namespace Detail
+    {
+        const uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+        const uint64_t FNV_PRIME = 0x100000001b3ULL;
+        const uint64_t GOLDEN_RATIO = 0x9e3779b97f4a7c15ULL;
+
+        // Finalizer used to derive independent hashes from the FNV hash of a
+        // key.
+        constexpr uint64_t mixHash(uint64_t value) noexcept{
+            value ^= value >> 30;
+            value *= 0xbf58476d1ce4e5b9ULL;
+            value ^= value >> 27;
+            value *= 0x94d049bb133111ebULL;
+            value ^= value >> 31;
+            return value;
+        }
+
+        constexpr uint64_t hashBytes(const char* key, size_t length) noexcept{
+            uint64_t hash = FNV_OFFSET;
+            for (size_t i = 0; i < length; i++) {
+                hash ^= (unsigned char)key[i];
+                hash *= FNV_PRIME;
+            }
+            return hash;
+        }
+
+        // These methods place a key hashed with hashBytes in the tables built
+        // by the hash and displace method: the bucket holding its
+        // displacement, and its slot given the seed of that bucket.
+        constexpr size_t bucketOf(uint64_t hash, size_t buckets) noexcept{
+            return (size_t)(mixHash(hash) % buckets);
+        }
+
+        constexpr size_t slotOf(uint64_t hash, int32_t seed, size_t slots) noexcept{
+            return (size_t)(mixHash(hash + (uint64_t)seed * GOLDEN_RATIO) % slots);
+        }
+    }
+
+    /**
+     * This class maps identifiers to tokens through a minimal perfect hash
+     * built with the hash and displace method. It is built once from the full
+     * set of identifiers and can not be modified afterwards.
+     * 
+     * Identifiers are stored without their prefixing dashes, and dashes are
+     * skipped when looking up a string. This matches the normalization done
+     * by ArgsTools::make_identifier, so "-name" and "--name" resolve to the
+     * same token, without having to validate or rebuild the string.
+     * 
+     * Lookups hash the string once, read one displacement value and compare
+     * against a single candidate. They never allocate.
+     */
+    class IdentifierTable{
+        public:
+            /**
+             * These are the constructors of the table. The contents of the
+             * table are allocated from the memory resource provided, or the
+             * default resource if none is.
+             * 
+             * @param {IdentifierTable} other The table to copy.
+             * @param {memory_resource*} resource The memory resource to allocate from.
+             */
+            explicit IdentifierTable(std::pmr::memory_resource* resource = nullptr);
+            IdentifierTable(const IdentifierTable& other, std::pmr::memory_resource* resource);
+
+            /**
+             * This method builds the table from a list of identifiers and their
+             * tokens, replacing its previous contents. Identifiers must be
+             * unique once stripped of their prefixing dashes.
+             * 
+             * @param {vector<pair<string_view, Token>>} identifiers The identifiers to store in the table.
+             */
+            void build(const std::vector<std::pair<std::string_view, Token>>& identifiers);
+
+            /**
+             * These methods look up an identifier in the table. Prefixing
+             * dashes are ignored.
+             * 
+             * @param {char*} identifier The identifier, either null terminated or of the length given.
+             * @param {size_t} length The length of the identifier.
+             * @return {Token} The token of the identifier if found. NULL_TOKEN otherwise.
+             */
+            Token find(const char* identifier) const noexcept;
+            Token find(const char* identifier, size_t length) const noexcept;
+
+            /**
+             * This method returns the number of identifiers in the table.
+             * 
+             * @return {size_t} The number of identifiers stored.
+             */
+            size_t size() const noexcept;
+
+        private:
+            struct Entry{
+                uint32_t offset;
+                uint32_t length;
+                Token token;
+            };
+
+            // The identifiers stripped of dashes, stored back to back.
+            std::pmr::vector<char> keys_;
+            // The identifier entries, indexed by slot.
+            std::pmr::vector<Entry> entries_;
+            // The displacement of each bucket. Negative values point directly
+            // to a slot (-value-1), positive values are hash seeds.
+            std::pmr::vector<int32_t> displacements_;
+
+            Token match(const char* key, size_t length, uint64_t hash) const noexcept;
+    };
+}
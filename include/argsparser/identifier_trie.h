@@ -0,0 +1,114 @@
+/**
+ * identifier_trie.h
+ *
+ * This file contains the declaration of the IdentifierTrie class, a prefix
+ * tree over the identifiers of a schema used to resolve abbreviations and to
+ * suggest identifiers close to a mistyped one.
+ *
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <argsparser/memory.h>
+#include <argsparser/token.h>
+
+namespace ArgsParser
+{
+    /**
+     * This class stores identifiers in a prefix tree. Like IdentifierTable,
+     * identifiers are stored without their prefixing dashes, and dashes are
+     * skipped when looking up a string.
+     *
+     * Nodes and edges are stored in flat arrays, with the edges of a node
+     * contiguous and sorted by character, so walking a string reads one small
+     * array per character. Every node records the token shared by all the
+     * identifiers below it, if there is one, so resolving an abbreviation
+     * never needs to visit the subtree.
+     */
+    class IdentifierTrie{
+        public:
+            /**
+             * These are the constructors of the trie. The contents of the
+             * trie are allocated from the memory resource provided, or the
+             * default resource if none is.
+             *
+             * @param {IdentifierTrie} other The trie to copy.
+             * @param {memory_resource*} resource The memory resource to allocate from.
+             */
+            explicit IdentifierTrie(std::pmr::memory_resource* resource = nullptr);
+            IdentifierTrie(const IdentifierTrie& other, std::pmr::memory_resource* resource);
+
+            /**
+             * This method builds the trie from a list of identifiers and their
+             * tokens, replacing its previous contents. Identifiers must be
+             * unique once stripped of their prefixing dashes.
+             *
+             * @param {vector<pair<string_view, Token>>} identifiers The identifiers to store in the trie.
+             */
+            void build(const std::vector<std::pair<std::string_view, Token>>& identifiers);
+
+            /**
+             * This method resolves an abbreviation, in the manner of GNU long
+             * options: a string matches an identifier it is a prefix of, as
+             * long as every identifier it is a prefix of belongs to the same
+             * argument. Prefixing dashes are ignored, and single character
+             * strings are never treated as abbreviations.
+             *
+             * @param {char*} identifier The identifier or abbreviation.
+             * @param {size_t} length The length of the identifier.
+             * @return {Token} The token of the argument if the abbreviation is unambiguous. NULL_TOKEN otherwise.
+             */
+            Token matchPrefix(const char* identifier, size_t length) const noexcept;
+
+            /**
+             * This method finds the identifiers closest to a string, by the
+             * number of characters inserted, removed, replaced or swapped with
+             * the next one to turn one into the other. Subtrees that can not
+             * be within the distance given are skipped.
+             *
+             * @param {std::string_view} identifier The string to find identifiers close to. Prefixing dashes are ignored.
+             * @param {size_t} max_distance The largest distance of an identifier to return.
+             * @param {size_t} max_results The largest number of identifiers to return.
+             * @return {vector<string>} The closest identifiers, nearest first, with their prefixing dashes.
+             */
+            std::vector<std::string> suggest(std::string_view identifier, size_t max_distance, size_t max_results) const;
+
+            /**
+             * This method returns the number of identifiers in the trie.
+             *
+             * @return {size_t} The number of identifiers stored.
+             */
+            size_t size() const noexcept;
+
+        private:
+            struct Node{
+                // The edges leaving the node, [first_edge, first_edge + edge_count).
+                uint32_t first_edge;
+                uint32_t edge_count;
+                // The token of the identifier ending at the node, if any.
+                Token token;
+                // The token shared by every identifier at or below the node,
+                // or NULL_TOKEN if they belong to different arguments.
+                Token unique;
+            };
+
+            struct Edge{
+                char label;
+                uint32_t child;
+            };
+
+            std::pmr::vector<Node> nodes_;
+            std::pmr::vector<Edge> edges_;
+            size_t size_;
+            size_t depth_;
+
+            uint32_t insert(const std::vector<std::pair<std::string_view, Token>>& keys, size_t first, size_t last, size_t depth);
+            const Node* child(const Node& node, char label) const noexcept;
+    };
+}
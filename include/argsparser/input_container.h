@@ -9,10 +9,91 @@
  */
 
 #pragma once
+#include <string_view>
 #include <argsparser/container.h>
 
 namespace ArgsParser
 {
+    /**
+     * This struct stores the parse state of an InputContainer, that is, the
+     * user input parsed to it and the result of its validation.
+     */
+    struct InputState : public ContainerState
+    {
+        // The list of user inputs parsed to the container. These refer either
+        // to argv itself or to a copy owned by the parse result.
+        std::pmr::vector<std::string_view> user_input;
+
+        // Whether validation succeeded, and the error message if it did not.
+        bool validation;
+        std::string validation_failure_reason;
+
+        // An asynchronous validation started but not yet awaited, with the
+        // input and the value it validates.
+        struct PendingValidation{
+            size_t input;
+            size_t value;
+            std::future<Status> result;
+        };
+
+        // The result of each part of the input while it is post-processed in
+        // parallel: the index of the first input rejected, or the end of the
+        // part if none was, and the reason. Asynchronous validations are kept
+        // until awaited, along with copies of the inputs they validate if the
+        // container is untyped. Empty once the parse is done.
+        struct Part{
+            size_t rejected;
+            std::string reason;
+            std::vector<PendingValidation> pending;
+            std::vector<std::string> inputs;
+        };
+        std::vector<Part> parts;
+        size_t part_size;
+
+        explicit InputState(std::pmr::memory_resource* resource = nullptr);
+        InputState(const InputState& other, std::pmr::memory_resource* resource);
+        virtual ~InputState();
+
+        /**
+         * This method returns the wrapped value of this state.
+         * 
+         * @return {ValueWrapper} The wrapped state and input stored in this state.
+         */
+        ValueWrapper getValue() const noexcept;
+
+        /**
+         * This method returns the validation state of the user input as a
+         * pair, with the first element being whether the validation was
+         * successful and the second being the error string generated.
+         * If the conversion of the input was deferred, it is run first.
+         * 
+         * @return {pair<bool, string>} The validation state and error message (if failure).
+         */
+        std::pair<bool, std::string> getValidation() const noexcept;
+
+        /**
+         * This method runs the conversion and validation of the user input if
+         * they were deferred by a lazy argument, and does nothing otherwise.
+         * It may be called from several threads at once, and the conversion
+         * runs only once.
+         */
+        virtual void forceConversion() const;
+
+        /**
+         * Cloning method. The clone is allocated from the same memory resource
+         * as this object.
+         * 
+         * @return {ContainerState*} A pointer to a new InputState object cloned from this object.
+         */
+        virtual InputState* clone() const;
+
+        /**
+         * This method destroys this state and returns its memory to the
+         * resource it was allocated from.
+         */
+        virtual void destroy() noexcept;
+    };
+
     /**
      * This class is used to parse for user inputted strings. It is based on 
      * the basic container class with additional methods to store and retrieve
@@ -29,22 +110,6 @@ namespace ArgsParser
              */
             virtual std::string getPlaceholderText() const noexcept;
 
-            /**
-             * This method retrieves user input how it was parsed from the
-             * command line. Only string conversion is performed.
-             * 
-             * @return {vector<string>} The list of user inputs parsed to this container.
-             */
-            std::vector<std::string> getUserInput() const noexcept;
-
-            /**
-             * This method returns the number of independent inputs parsed to this
-             * container.
-             * 
-             * @return {size_t} The size of the list of user inputs parsed to this container.
-             */
-            size_t getInputSize() const noexcept;
-
             /**
              * This method returns the maximum number of independent inputs that this
              * container can hold.
@@ -54,20 +119,22 @@ namespace ArgsParser
             size_t getMaxInputs() const noexcept;
 
             /**
-             * This method returns the wrapped value of this container.
+             * This method returns whether the conversion and validation of the
+             * input of this container is deferred until its value is first
+             * read. See Parser::setLazy.
              * 
-             * @return {ValueWrapper} The wrapped state and input stored in this container.
+             * @return {bool} Whether this container is lazy.
              */
-            ValueWrapper getValue() const noexcept;
+            bool isLazy() const noexcept;
 
             /**
-             * This method returns the validation state of the user input as a
-             * pair, with the first element being whether the validation was
-             * successful and the second being the error string generated.
+             * This method returns whether the value of this container may be
+             * read from the environment, a configuration file or a default
+             * when it is not found in the command line.
              * 
-             * @return {pair<bool, string>} The validation state and error message (if failure).
+             * @return {bool} Whether this container has a source other than the command line.
              */
-            std::pair<bool, std::string> getValidation() const noexcept;
+            bool hasFallback() const noexcept;
 
             /**
              * This is the constructor for the user input container.
@@ -81,6 +148,7 @@ namespace ArgsParser
              * @param {Validator} validator A function to use for input validation.
              * @param {ErrorHandler} error_callback A function to call if validation fails.
              * @param {Callback} callback A function to call if validation succeeds.
+             * @param {memory_resource*} resource The memory resource to allocate the strings of the container from.
              */
             InputContainer(
                 const ArgType type,
@@ -91,9 +159,39 @@ namespace ArgsParser
                 const size_t max_values = 1,
                 const Validator<std::string>& validator = nullptr,
                 const ErrorHandler& error_callback = nullptr,
-                const Callback& callback = nullptr
+                const Callback& callback = nullptr,
+                std::pmr::memory_resource* resource = nullptr
+            );
+
+            /**
+             * This is the constructor for the user input container taking
+             * identifiers that are already normalized. They are moved into
+             * the container when allocated from the same memory resource, and
+             * copied otherwise.
+             */
+            InputContainer(
+                const ArgType type,
+                const std::string& name,
+                std::pmr::vector<std::pmr::string>&& identifiers,
+                const std::string& description,
+                const std::string& placeholder_text,
+                const size_t max_values,
+                const Validator<std::string>& validator,
+                const ErrorHandler& error_callback,
+                const Callback& callback,
+                std::pmr::memory_resource* resource = nullptr
             );
 
+            /**
+             * This is the copy constructor for the user input container. The
+             * strings of the container are copied into the memory resource
+             * provided.
+             * 
+             * @param {InputContainer} other The container to copy.
+             * @param {memory_resource*} resource The memory resource to allocate the strings of the container from.
+             */
+            InputContainer(const InputContainer& other, std::pmr::memory_resource* resource);
+
             /**
              * This is the destructor for the user input container.
              */
@@ -102,23 +200,47 @@ namespace ArgsParser
             /**
              * Cloning method.
              * 
+             * @param {memory_resource*} resource The resource to allocate the clone from. Defaults to the resource of this object.
              * @return {Container*} A pointer to a new InputContainer object cloned from this object.
              */
-            virtual InputContainer* clone() const;
+            virtual InputContainer* clone(std::pmr::memory_resource* resource = nullptr) const;
+
+            /**
+             * This method destroys this container and returns its memory to the
+             * resource it was allocated from.
+             */
+            virtual void destroy() noexcept;
 
+            /**
+             * This method creates an empty parse state for this container.
+             * 
+             * @param {memory_resource*} resource The resource to allocate the state and its values from.
+             * @return {ContainerState*} A pointer to a new InputState object.
+             */
+            virtual InputState* createState(std::pmr::memory_resource* resource = nullptr) const;
 
         protected:
             const size_t max_values_;
 
-            std::string placeholder_text_;
-            std::vector<std::string> user_input_;
+            // Whether conversion is deferred until the value is first read.
+            // Only typed containers convert their input, so it has no effect
+            // on other containers.
+            bool lazy_;
+
+            std::pmr::string placeholder_text_;
 
             const Validator<std::string> validator_;
             const ErrorHandler error_callback_;
 
-            bool validation_;
-            std::string validation_failure_reason_;
+            // The sources the value is read from when the argument is not
+            // found in the command line, in order of precedence. Empty names
+            // are not read. See Parser::setEnvironment.
+            std::pmr::string environment_;
+            std::pmr::string config_key_;
+            std::pmr::string default_value_;
+            bool has_default_;
 
+            friend struct SchemaImpl;
             friend class Parser;
 
             /**
@@ -127,9 +249,10 @@ namespace ArgsParser
              * a value passed to the identifiers associated with this container
              * is found by the parser.
              * 
+             * @param {InputState} state The parse state to update.
              * @param {string} user_input The input to associate with this container.
              */
-            void setActive(const std::string& user_input);
+            void setActive(InputState& state, std::string_view user_input) const;
 
             /**
              * This method executes all post-processing logic associated with 
@@ -141,7 +264,53 @@ namespace ArgsParser
              * 
              * It is virtual, as the derived classes use different post-processing
              * logic to account for features such conversion. 
+             * 
+             * @param {ContainerState} state The parse state created by this container.
+             */
+            virtual void postProcess(ContainerState& state) const;
+
+            /**
+             * These methods validate the input in parts that may be processed
+             * in parallel. See Container::prepare.
+             * 
+             * @param {ContainerState} state The parse state created by this container.
+             * @param {size_t} part_size The largest number of inputs in a part.
+             * @param {size_t} part The index of the part to process.
+             * @return {size_t} The number of parts the input was split into.
+             */
+            virtual size_t prepare(ContainerState& state, size_t part_size) const;
+            virtual void process(ContainerState& state, size_t part) const;
+            virtual void complete(ContainerState& state) const;
+            virtual bool hasAsyncValidator() const noexcept;
+
+            /**
+             * This method waits for the asynchronous validations of a part,
+             * recording the first input they reject if it comes before the
+             * input rejected by the part itself.
+             * 
+             * @param {InputState::Part} part The part to await.
+             * @return {size_t} The index of the first value of the input rejected, or npos if none was.
+             */
+            size_t await(InputState::Part& part) const;
+
+            /**
+             * This method validates a range of the inputs of a state, stopping
+             * at the first one rejected.
+             * 
+             * @param {InputState} state The parse state created by this container.
+             * @param {size_t} first The index of the first input to validate.
+             * @param {size_t} last The index past the last input to validate.
+             * @param {string} reason Set to the reason the input was rejected, if one was.
+             * @return {size_t} The index of the input rejected, or last if none was.
+             */
+            size_t validate(const InputState& state, size_t first, size_t last, std::string& reason) const;
+
+            /**
+             * This method calls the callback if the input of a state is valid,
+             * and the error callback otherwise.
+             * 
+             * @param {InputState} state The parse state created by this container.
              */
-            virtual void postProcess();
+            void report(const InputState& state) const;
     };
 }
\ No newline at end of file
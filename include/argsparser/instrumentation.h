@@ -0,0 +1,147 @@
+/**
+ * instrumentation.h
+ *
+ * This file contains the declaration of the statistics recorded while
+ * parsing when the library is built with ARGSPARSER_INSTRUMENTATION, and the
+ * macros used to record them, which expand to nothing otherwise.
+ *
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace ArgsParser
+{
+    /**
+     * This struct holds the time spent in the user functions of a single
+     * argument while post-processing it, in nanoseconds. Arguments that are
+     * lazy or read from other sources than the command line are converted
+     * after the parse, and are not timed.
+     */
+    struct ArgumentStatistics
+    {
+        std::string name;
+        uint64_t converter_ns = 0;
+        uint64_t validator_ns = 0;
+        uint64_t callback_ns = 0;   // Including error callbacks.
+    };
+
+    /**
+     * This struct holds the timings and counters of a parse. They are only
+     * recorded when the library is built with ARGSPARSER_INSTRUMENTATION, in
+     * which case collected is set.
+     */
+    struct ParseStatistics
+    {
+        bool collected = false;
+
+        // The time spent in each phase of the parse, in nanoseconds. The
+        // scan covers reading the command line, including copying it and
+        // looking up identifiers, which are also timed apart.
+        uint64_t scan_ns = 0;
+        uint64_t lookup_ns = 0;
+        uint64_t post_process_ns = 0;
+
+        // The number of tokens read, and of tokens starting with a dash that
+        // were or were not found among the identifiers of the schema.
+        uint64_t tokens = 0;
+        uint64_t lookup_hits = 0;
+        uint64_t lookup_misses = 0;
+
+        // The number of allocations made from the memory resource of the
+        // result, and the bytes allocated, including any made after the
+        // parse by lazy conversions.
+        uint64_t allocations = 0;
+        uint64_t allocated_bytes = 0;
+
+        // The arguments found, in the order they were post-processed.
+        std::vector<ArgumentStatistics> arguments;
+    };
+
+#ifdef ARGSPARSER_INSTRUMENTATION
+    namespace Detail
+    {
+        // The statistics of the argument being post-processed by this thread.
+        extern thread_local ArgumentStatistics* current_argument;
+
+        /**
+         * This class adds the time it is alive for to a counter, if one is
+         * given.
+         */
+        class ScopeTimer{
+            public:
+                explicit ScopeTimer(uint64_t* total) noexcept :
+                    total_(total),
+                    start_(total != nullptr? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point())
+                    { };
+                ~ScopeTimer(){
+                    if (total_ != nullptr)
+                        *total_ += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+                };
+            private:
+                uint64_t* total_;
+                std::chrono::steady_clock::time_point start_;
+        };
+
+        /**
+         * This method calls a function, adding the time it takes to a field of
+         * the statistics of the argument being post-processed, if any.
+         */
+        template <typename F>
+        decltype(auto) timeArgument(uint64_t ArgumentStatistics::* field, F function){
+            ScopeTimer timer(current_argument != nullptr? &(current_argument->*field) : nullptr);
+            return function();
+        }
+
+        /**
+         * This class counts the allocations made from another memory resource.
+         */
+        class CountingResource : public std::pmr::memory_resource{
+            public:
+                explicit CountingResource(std::pmr::memory_resource* upstream) noexcept :
+                    upstream_(upstream), allocations_(0), bytes_(0) { };
+
+                std::pmr::memory_resource* upstream() const noexcept { return upstream_; };
+                uint64_t allocations() const noexcept { return allocations_.load(std::memory_order_relaxed); };
+                uint64_t bytes() const noexcept { return bytes_.load(std::memory_order_relaxed); };
+
+            private:
+                std::pmr::memory_resource* upstream_;
+                std::atomic<uint64_t> allocations_;
+                std::atomic<uint64_t> bytes_;
+
+                void* do_allocate(size_t bytes, size_t alignment) override {
+                    allocations_.fetch_add(1, std::memory_order_relaxed);
+                    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+                    return upstream_->allocate(bytes, alignment);
+                };
+                void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+                    upstream_->deallocate(pointer, bytes, alignment);
+                };
+                bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                    return this == &other;
+                };
+        };
+    }
+#endif
+}
+
+// These macros record a statistic of a parse. They take the result being
+// parsed to, or the field of the argument being post-processed to add the
+// time of an expression to, and do nothing unless instrumentation is built.
+#ifdef ARGSPARSER_INSTRUMENTATION
+#define ARGSPARSER_TIME_PHASE(result, field) ::ArgsParser::Detail::ScopeTimer argsparser_phase_timer_(&(result).statistics_->field)
+#define ARGSPARSER_COUNT(result, field) (++(result).statistics_->field)
+#define ARGSPARSER_TIME_ARGUMENT(field, ...) ::ArgsParser::Detail::timeArgument(&::ArgsParser::ArgumentStatistics::field, [&](){ return __VA_ARGS__; })
+#else
+#define ARGSPARSER_TIME_PHASE(result, field)
+#define ARGSPARSER_COUNT(result, field) ((void)0)
+#define ARGSPARSER_TIME_ARGUMENT(field, ...) (__VA_ARGS__)
+#endif
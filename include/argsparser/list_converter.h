@@ -0,0 +1,222 @@
+/**
+ * list_converter.h
+ * 
+ * This file contains the declaration of the ListConverter class, used to
+ * convert arguments holding a delimited list of numbers, such as "1,2,3".
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <argsparser/converters.h>
+
+namespace ArgsParser
+{
+    namespace Detail
+    {
+        // The number of bytes of a list scanned for delimiters at once.
+        const size_t LIST_BLOCK_SIZE = 2048;
+
+        /**
+         * This method finds every occurrence of a delimiter in a block of at
+         * most LIST_BLOCK_SIZE bytes, using the widest vector instructions
+         * supported by the processor (AVX2 or SSE2).
+         * 
+         * @param {char*} data The block to scan.
+         * @param {size_t} size The size of the block.
+         * @param {char} delimiter The delimiter to find.
+         * @param {uint32_t*} positions The array to store the offset of each delimiter in.
+         * @return {size_t} The number of delimiters found.
+         */
+        size_t findDelimiters(const char* data, size_t size, char delimiter, uint32_t* positions) noexcept;
+
+        /**
+         * This method parses consecutive elements of a block of a list as
+         * 64-bit integers, sixteen digits at a time with SSSE3 where
+         * supported. It stops at the first element that is not a plain run of
+         * at most 19 digits, preceded by '-' if signed, or that does not fit
+         * in a 64-bit integer.
+         * 
+         * The first element begins at begin, and every other element one
+         * character after the end of the previous one.
+         * 
+         * @param {char*} lower The start of the list. Nothing before it is read.
+         * @param {char*} block The block the offsets of the ends are relative to.
+         * @param {uint32_t*} ends The offset of the end of each element.
+         * @param {size_t} count The number of elements.
+         * @param {char*} begin The first character of the first element.
+         * @param {bool} is_signed Whether to parse signed integers.
+         * @param {uint64_t*} values The array to store the integers in, as two's complement if signed.
+         * @return {size_t} The number of elements parsed.
+         */
+        size_t parseIntegers(
+            const char* lower,
+            const char* block,
+            const uint32_t* ends,
+            size_t count,
+            const char* begin,
+            bool is_signed,
+            uint64_t* values
+        ) noexcept;
+    }
+
+    /**
+     * This class converts an input holding a list of numbers separated by a
+     * delimiter, such as "1,2,3", appending every number to the converted
+     * values of the argument. It can be passed anywhere a Converter<T> is
+     * expected:
+     *      myParser.registerOption<int>("ids", {"ids"}, "list", "", 1, nullptr, ArgsParser::ListConverter<int>());
+     * 
+     * Delimiters are located with vector instructions, and integers are parsed
+     * with vector instructions as well, so long lists convert several times
+     * faster than splitting them and converting each element. Numbers must be
+     * formatted as for convertNumber, and empty elements are rejected.
+     */
+    template <typename T>
+    class ListConverter{
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "ListConverter requires a numeric type.");
+
+        public:
+            /**
+             * Constructor of the list converter.
+             * 
+             * @param {char} delimiter The character separating the numbers.
+             */
+            explicit ListConverter(char delimiter = ',') noexcept : delimiter_(delimiter) {};
+
+            /**
+             * This method converts a list, appending each number to a vector.
+             * If an element is invalid, the elements before it remain in the
+             * vector.
+             * 
+             * @param {std::string_view} input The list.
+             * @param {pmr::vector<T>} output The vector to append the numbers to.
+             * @return {Status} Whether every element is a valid number, and the reason if not.
+             */
+            Status operator()(std::string_view input, std::pmr::vector<T>& output) const;
+
+            /**
+             * This method returns the delimiter separating the numbers.
+             * 
+             * @return {char} The delimiter.
+             */
+            char getDelimiter() const noexcept { return delimiter_; };
+
+        private:
+            char delimiter_;
+
+            /**
+             * This method converts the elements of a block of the list.
+             * 
+             * @param {char*} lower The start of the list.
+             * @param {char*} block The block the offsets of the ends are relative to.
+             * @param {uint32_t*} ends The offset of the end of each element.
+             * @param {size_t} count The number of elements.
+             * @param {char*} begin The first character of the first element.
+             * @param {pmr::vector<T>} output The vector to append the numbers to.
+             * @return {Status} Whether every element is a valid number, and the reason if not.
+             */
+            static Status convertBlock(
+                const char* lower,
+                const char* block,
+                const uint32_t* ends,
+                size_t count,
+                const char* begin,
+                std::pmr::vector<T>& output
+            );
+
+            /**
+             * This method converts a single element of the list with
+             * convertNumber.
+             * 
+             * @param {char*} begin The first character of the element.
+             * @param {char*} end The end of the element.
+             * @param {pmr::vector<T>} output The vector to append the number to.
+             * @return {Status} Whether the element is a valid number, and the reason if not.
+             */
+            static Status convertElement(const char* begin, const char* end, std::pmr::vector<T>& output);
+    };
+
+
+    /////////////////////// Template Method Definitions ///////////////////////
+
+    template <typename T>
+    Status ListConverter<T>::operator()(std::string_view input, std::pmr::vector<T>& output) const {
+        if (input.empty()) return Status();
+
+        const char* data = input.data();
+        uint32_t ends[Detail::LIST_BLOCK_SIZE + 1];
+        const char* begin = data;
+        for (size_t block = 0; block < input.size(); block += Detail::LIST_BLOCK_SIZE) {
+            size_t size = std::min(input.size() - block, Detail::LIST_BLOCK_SIZE);
+            size_t count = Detail::findDelimiters(data + block, size, delimiter_, ends);
+
+            // The end of the input ends the last element.
+            if (block + size == input.size()) ends[count++] = (uint32_t)size;
+
+            // Grow geometrically, as reserving exactly would reallocate for
+            // every block.
+            if (output.capacity() < output.size() + count)
+                output.reserve(std::max(output.size() + count, output.capacity() * 2));
+
+            Status status = convertBlock(data, data + block, ends, count, begin, output);
+            if (!status) return status;
+            if (count > 0) begin = data + block + ends[count - 1] + 1;
+        }
+        return Status();
+    };
+
+    template <typename T>
+    Status ListConverter<T>::convertBlock(
+        const char* lower,
+        const char* block,
+        const uint32_t* ends,
+        size_t count,
+        const char* begin,
+        std::pmr::vector<T>& output
+    ){
+        size_t done = 0;
+        while (done < count) {
+            if constexpr (std::is_integral_v<T>) {
+                uint64_t values[Detail::LIST_BLOCK_SIZE + 1];
+                size_t parsed = Detail::parseIntegers(lower, block, ends + done, count - done, begin, std::is_signed_v<T>, values);
+                for (size_t i = 0; i < parsed; i++) {
+                    bool in_range = std::is_signed_v<T>
+                        ? (int64_t)values[i] >= (int64_t)std::numeric_limits<T>::min() && (int64_t)values[i] <= (int64_t)std::numeric_limits<T>::max()
+                        : values[i] <= (uint64_t)std::numeric_limits<T>::max();
+
+                    // Let convertNumber describe the failure.
+                    if (!in_range) return convertElement(i == 0? begin : block + ends[done + i - 1] + 1, block + ends[done + i], output);
+                    output.push_back((T)values[i]);
+                }
+                if (parsed > 0) begin = block + ends[done + parsed - 1] + 1;
+                done += parsed;
+                if (done == count) break;
+            }
+
+            // Elements the fast path cannot parse, and floating-point numbers,
+            // are converted by convertNumber.
+            Status status = convertElement(begin, block + ends[done], output);
+            if (!status) return status;
+            begin = block + ends[done] + 1;
+            done++;
+        }
+        return Status();
+    };
+
+    template <typename T>
+    Status ListConverter<T>::convertElement(const char* begin, const char* end, std::pmr::vector<T>& output) {
+        Expected<T> value = convertNumber<T>(std::string_view(begin, (size_t)(end - begin)));
+        if (!value) return Failure(value.error());
+        output.push_back(value.value());
+        return Status();
+    };
+}
@@ -0,0 +1,51 @@
+/**
+ * mapped_file.h
+ * 
+ * This file contains the declaration of the MappedFile class, used to read
+ * files the parser takes input from without copying them.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace ArgsParser
+{
+    /**
+     * This class maps a file into memory for as long as it is alive.
+     * 
+     * The mapping is private and writable, so the contents can be modified in
+     * place (such as to remove quotes and escapes) without affecting the file.
+     * Only the pages actually written to are copied by the system.
+     */
+    class MappedFile{
+        public:
+            /**
+             * Constructor of the mapped file.
+             * 
+             * @param {std::string} path The path of the file to map.
+             * @except {std::runtime_error} The file could not be opened or mapped.
+             */
+            explicit MappedFile(const std::string& path);
+            MappedFile(const MappedFile& other) = delete;
+            MappedFile& operator=(const MappedFile& other) = delete;
+            ~MappedFile();
+
+            /**
+             * These methods return the contents of the file and their size.
+             * 
+             * @return {char*|size_t} The first byte of the mapping, or its size.
+             */
+            char* data() noexcept;
+            size_t size() const noexcept;
+
+        private:
+            char* data_;
+            size_t size_;
+        #ifdef _WIN32
+            void* mapping_;
+        #endif
+    };
+}
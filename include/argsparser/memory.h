@@ -0,0 +1,64 @@
+/**
+ * memory.h
+ * 
+ * This file contains the helpers used to allocate the objects of the library
+ * from a polymorphic memory resource.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <memory_resource>
+#include <utility>
+
+namespace ArgsParser
+{
+    /**
+     * This method returns the resource to allocate from, which is the default
+     * memory resource if none was given.
+     * 
+     * @param {memory_resource*} resource The resource requested by the user, or nullptr.
+     * @return {memory_resource*} The resource to allocate from.
+     */
+    inline std::pmr::memory_resource* resolve(std::pmr::memory_resource* resource) noexcept{
+        return resource != nullptr? resource : std::pmr::get_default_resource();
+    }
+
+    /**
+     * This method allocates an object from a memory resource and constructs
+     * it. The resource is passed to the constructor as its last argument, so
+     * that the object can allocate its own members from it.
+     * 
+     * Objects created this way must be released through dispose().
+     * 
+     * @param {memory_resource*} resource The resource to allocate from.
+     * @param {Args...} args The arguments to the constructor of T.
+     * @return {T*} A pointer to the new object.
+     */
+    template <typename T, typename... Args>
+    T* create(std::pmr::memory_resource* resource, Args&&... args){
+        resource = resolve(resource);
+        void* memory = resource->allocate(sizeof(T), alignof(T));
+        try {
+            return ::new (memory) T(std::forward<Args>(args)..., resource);
+        }
+        catch (...) {
+            resource->deallocate(memory, sizeof(T), alignof(T));
+            throw;
+        }
+    }
+
+    /**
+     * This method destroys an object created through create() and returns its
+     * memory to the resource. T must be the dynamic type of the object.
+     * 
+     * @param {T*} object The object to destroy.
+     * @param {memory_resource*} resource The resource the object was allocated from.
+     */
+    template <typename T>
+    void dispose(T* object, std::pmr::memory_resource* resource) noexcept{
+        object->~T();
+        resource->deallocate(object, sizeof(T), alignof(T));
+    }
+}
@@ -0,0 +1,276 @@
+/**
+ * parse_result.h
+ * 
+ * This file contains the declaration of the ParseResult class, which stores
+ * the outcome of parsing a single command line against a CompiledSchema.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <argsparser/instrumentation.h>
+#include <argsparser/schema.h>
+#include <argsparser/span.h>
+#include <argsparser/thread_pool.h>
+#include <argsparser/typed_input_container.h>
+
+namespace ArgsParser
+{
+    typedef std::unique_ptr<ContainerState, StateDeleter> StatePointer;
+
+    /**
+     * This class stores the state of every argument found while parsing a
+     * command line. It keeps a reference to the schema it was parsed with, so
+     * values can be retrieved by name, identifier or token.
+     * 
+     * States are only created for the arguments actually found in the command
+     * line, so a result is cheap to create and throw away. States, their
+     * values and the copy of the command line are allocated from the memory
+     * resource given in ParseOptions.
+     * 
+     * None of the const methods modify the result, so it may be read from
+     * several threads at once.
+     */
+    class ParseResult{
+        public:
+            ParseResult();
+            ParseResult(const ParseResult& other);  // Copy constructor.
+            ParseResult(ParseResult&& other);       // Move constructor.
+            ParseResult& operator=(ParseResult other);
+            ~ParseResult();
+
+            friend void swap(ParseResult& first, ParseResult& second);
+
+            /**
+             * These methods return the wrapped value of an argument. Given a
+             * TypedToken, the value is read without looking up the name or
+             * checking the type of the argument.
+             * @param {std::string|Token} The name, identifier or token of the argument.
+             * @return {ValueWrapper} The wrapped state and input of the argument.
+             */
+            ValueWrapper getValue(const std::string& name) const noexcept;
+            ValueWrapper getValue(const Token& token) const noexcept;
+            template <typename T> TypedValueWrapper<T> getValue(const std::string& name) const noexcept;
+            template <typename T> TypedValueWrapper<T> getValue(const Token& token) const noexcept;
+            template <typename T> TypedValueWrapper<T> getValue(const TypedToken<T>& token) const noexcept;
+
+            /**
+             * These methods return the raw user input of an argument as views,
+             * without copying it. The views remain valid for as long as this
+             * result (or a copy of it) is alive, and, when parsed with
+             * ParseOptions::zero_copy, for as long as argv is.
+             * @param {std::string|Token} The name, identifier or token of the argument.
+             * @return {Span<std::string_view>} The user input of the argument. Empty if it was not found.
+             */
+            Span<std::string_view> getValueView(const std::string& name) const noexcept;
+            Span<std::string_view> getValueView(const Token& token) const noexcept;
+
+            /**
+             * These methods return the converted values of a typed argument as
+             * a view into this result, without copying them. Reading an
+             * argument with thousands of values this way is O(1) and does not
+             * allocate. The view remains valid for as long as this result is
+             * alive.
+             * @param {std::string|Token} The name, identifier or token of the argument.
+             * @return {Span<T>} The converted values of the argument. Empty if it was not found or is not of type T.
+             */
+            template <typename T> Span<T> getValueView(const std::string& name) const noexcept;
+            template <typename T> Span<T> getValueView(const Token& token) const noexcept;
+            template <typename T> Span<T> getValueView(const TypedToken<T>& token) const noexcept;
+
+            /**
+             * This method returns whether an argument was found in the command
+             * line.
+             * @param {Token} token The token of the argument.
+             * @return {bool} Whether the argument is active.
+             */
+            bool isActive(const Token& token) const noexcept;
+
+            /**
+             * This method gets the parse state of an argument.
+             * @param {Token} token The token of the argument.
+             * @return {ContainerState*} The state, or nullptr if the argument was not found in the command line.
+             */
+            const ContainerState* getState(const Token& token) const noexcept;
+
+            /**
+             * This method gets the program name. This is the name set by the
+             * user in the schema if there is one, otherwise the name parsed from
+             * the command line.
+             * @return {std::string} The name of the program.
+             */
+            std::string getProgramName() const noexcept;
+
+            /**
+             * This method gets the schema this result was parsed with.
+             * @return {CompiledSchema} The schema.
+             */
+            const CompiledSchema& getSchema() const noexcept;
+
+            /**
+             * This method gets the memory resource the states of this result
+             * are allocated from.
+             * @return {memory_resource*} The memory resource of this result.
+             */
+            std::pmr::memory_resource* getMemoryResource() const noexcept;
+
+            /**
+             * These methods run every conversion deferred by a lazy argument,
+             * along with its callback, so that later reads do no work. The
+             * conversions of different arguments may be spread over a thread
+             * pool; each still runs only once.
+             * @param {ThreadPool} pool The pool to run the conversions on, if any.
+             */
+            void forceConversions() const;
+            void forceConversions(ThreadPool& pool) const;
+
+            /**
+             * This method returns the timings and counters recorded while
+             * parsing. They are only recorded when the library is built with
+             * ARGSPARSER_INSTRUMENTATION (see ParseStatistics::collected), and
+             * are all zero otherwise.
+             * @return {ParseStatistics} A copy of the statistics of the parse.
+             */
+            ParseStatistics getStatistics() const;
+
+        private:
+            CompiledSchema schema_;
+            std::string program_name_;
+            std::pmr::memory_resource* resource_;
+
+        #ifdef ARGSPARSER_INSTRUMENTATION
+            // The statistics of the parse, and the resource counting the
+            // allocations of the result. The states and buffers below are
+            // returned to the counting resource, so it is declared first.
+            std::shared_ptr<Detail::CountingResource> counter_;
+            std::shared_ptr<ParseStatistics> statistics_;
+        #endif
+
+            // The buffers referred to by the user input stored in this result.
+            // They are immutable, so copies of the result share them.
+            std::vector<std::shared_ptr<const char>> buffers_;
+
+            /**
+             * These vectors store the state of each registered argument by
+             * position, and are null for arguments not found in the command
+             * line.
+             */
+            std::vector<StatePointer> positional_states_;
+            std::vector<StatePointer> switch_states_;
+            std::vector<StatePointer> option_states_;
+
+            // The states read from sources other than the command line, if
+            // the schema has any. See Parser::setEnvironment.
+            struct Fallbacks;
+            std::shared_ptr<Fallbacks> fallbacks_;
+
+            friend class CompiledSchema;
+            friend class Parser;
+            friend struct SchemaImpl;
+
+            ParseResult(const CompiledSchema& schema, std::pmr::memory_resource* resource);
+
+            /**
+             * This method gets the registry of states for an argument type.
+             * @param {ArgType} type The type of argument.
+             * @return {vector<StatePointer>*} The registry, or nullptr for ArgType::Null.
+             */
+            std::vector<StatePointer>* getStates(ArgType type) noexcept;
+            const std::vector<StatePointer>* getStates(ArgType type) const noexcept;
+
+            /**
+             * This method gets the mutable state of an argument.
+             * @param {Token} token The token of the argument.
+             * @return {ContainerState*} The state, or nullptr if the argument has not been activated.
+             */
+            ContainerState* getMutableState(const Token& token) noexcept;
+
+            /**
+             * This method gets the state of a typed argument. The type of the
+             * state is known from the token, so it is neither checked nor
+             * looked up by name.
+             * @param {TypedToken<T>} token The token of the argument.
+             * @return {TypedInputState<T>*} The state, or nullptr if the argument was not found in the command line.
+             */
+            template <typename T> const TypedInputState<T>* getTypedState(const TypedToken<T>& token) const noexcept;
+
+            /**
+             * This method gets the state of an argument missing from the
+             * command line from its other sources, reading them the first
+             * time it is called for the argument.
+             * @param {Token} token The token of the argument.
+             * @return {ContainerState*} The state, or nullptr if none of the sources of the argument has a value.
+             */
+            const ContainerState* getFallbackState(const Token& token) const noexcept;
+
+            /**
+             * This method gets the state of an argument, creating it from the
+             * container if the argument has not been activated yet.
+             * @param {Token} token The token of the argument.
+             * @param {Container*} container The container of the argument.
+             * @return {ContainerState*} The state of the argument.
+             */
+            ContainerState* activate(const Token& token, const Container* container);
+
+            /**
+             * This method gets the states of every argument found in the
+             * command line that takes input.
+             * @return {vector<const InputState*>} The states, by type and position.
+             */
+            std::vector<const InputState*> getInputStates() const;
+    };
+
+
+    ////////////////////// Definition of Template Methods //////////////////////////////
+
+
+    template <typename T>
+    TypedValueWrapper<T> ParseResult::getValue(const std::string& name) const noexcept {
+        return getValue<T>(schema_.isRegistered(name));
+    };
+
+    template <typename T>
+    TypedValueWrapper<T> ParseResult::getValue(const Token& token) const noexcept {
+        const TypedInputState<T>* state = dynamic_cast<const TypedInputState<T>*>(getState(token));
+        if (state == nullptr) return TypedValueWrapper<T>();
+        return state->getConvertedValue();
+    };
+
+    template <typename T>
+    TypedValueWrapper<T> ParseResult::getValue(const TypedToken<T>& token) const noexcept {
+        const TypedInputState<T>* state = getTypedState(token);
+        if (state == nullptr) return TypedValueWrapper<T>();
+        return state->getConvertedValue();
+    };
+
+    template <typename T>
+    Span<T> ParseResult::getValueView(const std::string& name) const noexcept {
+        return getValueView<T>(schema_.isRegistered(name));
+    };
+
+    template <typename T>
+    Span<T> ParseResult::getValueView(const Token& token) const noexcept {
+        const TypedInputState<T>* state = dynamic_cast<const TypedInputState<T>*>(getState(token));
+        if (state == nullptr) return Span<T>();
+        return state->getConvertedView();
+    };
+
+    template <typename T>
+    Span<T> ParseResult::getValueView(const TypedToken<T>& token) const noexcept {
+        const TypedInputState<T>* state = getTypedState(token);
+        if (state == nullptr) return Span<T>();
+        return state->getConvertedView();
+    };
+
+    template <typename T>
+    const TypedInputState<T>* ParseResult::getTypedState(const TypedToken<T>& token) const noexcept {
+        // Typed arguments are only ever positionals or options.
+        if (token.type != ArgType::Positional && token.type != ArgType::Option) return nullptr;
+        const std::vector<StatePointer>& states = token.type == ArgType::Positional? positional_states_ : option_states_;
+        if (token.position >= states.size()) return nullptr;
+        const ContainerState* state = states[token.position].get();
+        if (state == nullptr && fallbacks_) state = getFallbackState(token);
+        return static_cast<const TypedInputState<T>*>(state);
+    };
+}
\ No newline at end of file
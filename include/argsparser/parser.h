@@ -12,13 +12,47 @@
 #include <limits>
 #include <token.h>
 #include <argsparser/typed_input_container.h>
+#include <argsparser/parse_result.h>
 #include <argsparser/util.h>
 
 namespace ArgsParser
 { 
+    /**
+     * This struct describes an argument to register through
+     * Parser::registerMany. The fields mirror the parameters of
+     * registerSwitch, registerOption and registerPositional; those that do
+     * not apply to the type of the argument are ignored.
+     */
+    struct ArgumentSpec
+    {
+        ArgType type = ArgType::Null;
+        std::string name;
+        std::vector<std::string> identifiers;
+        std::string description = "Description not given.";
+        std::string placeholder_text = "value";
+        size_t max_values = 1;
+        Callback callback = nullptr;
+        Validator<std::string> validator = nullptr;
+        ErrorHandler error_callback = nullptr;
+    };
+
     /**
      * This is the base Parser class. It provides basic parsing and auto-help
      * without additional features such as parameter validation.
+     * 
+     * Registration and parse() modify the parser and must not run
+     * concurrently with any other call. Once parse() returns, every const
+     * method (getValue, getValueView, isRegistered, getContainer and so on)
+     * only reads from the parser, so values may be read from any number of
+     * threads without locking until the parser is modified again.
+     * 
+     * The first read of a lazy argument, or of an argument read from the
+     * environment, a configuration file or a default, runs its converter,
+     * validator and callbacks on the reading thread, so these must be safe
+     * to call from any thread that reads the argument. Other threads reading
+     * it wait until they return. This work allocates from the default heap
+     * rather than the memory resource of the parser, so the resource does
+     * not need to be thread safe for reads.
      */
     class Parser{
         struct ParserImpl;
@@ -31,8 +65,27 @@ namespace ArgsParser
         ErrorHandler error_callback_;
         
         public:
+            /**
+             * These are the constructors of the parser. If a memory resource is
+             * given, every registered container, identifier string and lookup
+             * structure is allocated from it, as well as parse results unless
+             * ParseOptions specifies otherwise. A monotonic_buffer_resource
+             * turns registration into pointer bumps and releases the whole
+             * parser at once. The resource must outlive the parser, its copies
+             * and any schema or result obtained from it.
+             * 
+             * Copies share the registered arguments with the original, so
+             * copying a parser costs the same however many arguments it has.
+             * Either parser copies them the first time it registers or
+             * changes an argument, leaving the other unaffected.
+             */
             Parser();
-            Parser(bool no_except, ErrorHandler error_callback = ArgsTools::print_error);
+            explicit Parser(std::pmr::memory_resource* resource);
+            Parser(
+                bool no_except,
+                ErrorHandler error_callback = ArgsTools::print_error,
+                std::pmr::memory_resource* resource = nullptr
+            );
             Parser(const Parser& other);        // Copy constructor.
             Parser(Parser&& other);             // Move constructor.
             Parser& operator=(Parser other);    // Assignment operator
@@ -42,8 +95,28 @@ namespace ArgsParser
 
             ValueWrapper getValue(const std::string& name) const noexcept;
             ValueWrapper getValue(const Token& token) const noexcept;
-            template <typename T> const TypedValueWrapper<T> getValue(const std::string& name) const noexcept;
-            template <typename T> const TypedValueWrapper<T> getValue(const Token& token) const noexcept;
+            template <typename T> TypedValueWrapper<T> getValue(const std::string& name) const noexcept;
+            template <typename T> TypedValueWrapper<T> getValue(const Token& token) const noexcept;
+            template <typename T> TypedValueWrapper<T> getValue(const TypedToken<T>& token) const noexcept;
+
+            /**
+             * These methods return the raw user input of an argument as views
+             * into the parsed command line, without copying it.
+             * @param {std::string|Token} The name, identifier or token of the argument.
+             * @return {Span<std::string_view>} The user input of the argument.
+             */
+            Span<std::string_view> getValueView(const std::string& name) const noexcept;
+            Span<std::string_view> getValueView(const Token& token) const noexcept;
+
+            /**
+             * These methods return the converted values of a typed argument as
+             * a view into the parse result, without copying them.
+             * @param {std::string|Token} The name, identifier or token of the argument.
+             * @return {Span<T>} The converted values of the argument.
+             */
+            template <typename T> Span<T> getValueView(const std::string& name) const noexcept;
+            template <typename T> Span<T> getValueView(const Token& token) const noexcept;
+            template <typename T> Span<T> getValueView(const TypedToken<T>& token) const noexcept;
 
             const unsigned short& error_code;
             const std::string& error_description;
@@ -71,6 +144,15 @@ namespace ArgsParser
              */
             Token isIdentifierRegistered(const std::string& identifier) const noexcept;
 
+            /**
+             * These methods resolve abbreviations of identifiers and suggest
+             * identifiers close to a mistyped one. See
+             * CompiledSchema::matchIdentifier and
+             * CompiledSchema::suggestIdentifiers.
+             */
+            Token matchIdentifier(const std::string& identifier) const noexcept;
+            std::vector<std::string> suggestIdentifiers(const std::string& identifier, size_t max_distance = 2, size_t max_results = 3) const;
+
             /**
              * This method register a positional argument to the parser. Usage example:
              *      ArgsParser.register_positional(
@@ -96,11 +178,11 @@ namespace ArgsParser
              * @param {Converter} converter The converter method to use for converting string input to type T.
              * @param {Callback} error_callback A method to call in case validation fails.
              * @param {Callback} callback A method to call in case validation succeeds.
-             * @return {Token} The token to retrieve the argument value by Id.
+             * @return {Token} The token to retrieve the argument value by Id. The typed overload returns a TypedToken<T>.
              * @except {std::runtime_error} Registration failure.
              */
             template <typename T>
-            Token registerPositional(
+            TypedToken<T> registerPositional(
                 const std::string& name,
                 const std::string& placeholder_text,
                 const Callback& callback = nullptr,
@@ -173,11 +255,11 @@ namespace ArgsParser
              * @param {Converter} converter The converter method to use for converting string input to type T.
              * @param {Callback} error_callback A function to call if validation fails.
              * @param {Callback} callback A function to be called if validation succeeds.
-             * @return {Token} The token to retrieve the argument value by Id.
+             * @return {Token} The token to retrieve the argument value by Id. The typed overload returns a TypedToken<T>.
              * @except {std::runtime_error} Registration failure.
              */
             template <typename T>
-            Token registerOption(
+            TypedToken<T> registerOption(
                 const std::string& name,
                 const std::vector<std::string>& identifiers,
                 const std::string& placeholder_text = "value",
@@ -199,6 +281,34 @@ namespace ArgsParser
                 const ErrorHandler& error_callback = nullptr
             );
 
+            /**
+             * This method registers a batch of arguments at once. Usage example:
+             *      std::vector<ArgsParser::ArgumentSpec> specs(2);
+             *      specs[0].type = ArgsParser::ArgType::Switch;
+             *      specs[0].name = "verbose";
+             *      specs[0].identifiers = {"v", "verbose"};
+             *      specs[1].type = ArgsParser::ArgType::Option;
+             *      specs[1].name = "jobs";
+             *      specs[1].identifiers = {"j", "jobs"};
+             *      std::vector<ArgsParser::Token> tokens = Parser.registerMany(specs);
+             * 
+             * Every name and identifier is checked against those already
+             * registered and against the rest of the batch in a single pass,
+             * and the tables of the parser are grown once for the whole batch.
+             * This is much faster than registering a large number of arguments
+             * one at a time.
+             * 
+             * Registration is all or nothing. If any argument cannot be
+             * registered, none are, and every conflict found is reported
+             * together, separated by "; ", in the same way as the other
+             * registration methods report a single one.
+             * 
+             * @param {std::vector<ArgumentSpec>} specs The arguments to register.
+             * @return {std::vector<Token>} The token of each argument, in order, or an empty vector if registration failed.
+             * @except {std::runtime_error} Registration failure.
+             */
+            std::vector<Token> registerMany(const std::vector<ArgumentSpec>& specs);
+
             /**
              * This method returns a vector of all tokens that have been
              * registered to the parser.
@@ -216,7 +326,7 @@ namespace ArgsParser
             /**
              * This method gets a registered container by it's token.
              * @param {Token} The registration token.
-             * @return {Container*} The container.
+             * @return {Container*} The container, or nullptr if not registered.
              */
             const Container* getContainer(const std::string& name) const noexcept;
             const Container* getContainer(const Token& token) const noexcept;
@@ -234,6 +344,66 @@ namespace ArgsParser
              */
             void setProgramName(const std::string& name);
 
+            /**
+             * This method makes an argument lazy, so that its user input is
+             * only converted and validated the first time its value or
+             * validation is read, and the result is kept for later reads. The
+             * callback or error callback of the argument runs at that point
+             * instead of during parsing.
+             * 
+             * This avoids the cost of converting arguments that are parsed but
+             * never read. Only arguments with typed input can be lazy. As the
+             * value may be converted on any thread that reads it, its
+             * converted values are allocated from the default heap rather than
+             * the memory resource of the result.
+             * 
+             * @param {std::string|Token} The name, identifier or token of the argument.
+             * @param {bool} lazy Whether the argument should be lazy.
+             * @return {bool} True if the argument was found and takes input. False otherwise.
+             */
+            bool setLazy(const std::string& name, bool lazy = true);
+            bool setLazy(const Token& token, bool lazy = true);
+
+            /**
+             * These methods set the sources the value of an argument is read
+             * from when it is not found in the command line. In order of
+             * precedence, these are an environment variable, a key of the
+             * configuration file named by ParseOptions::config_file, and a
+             * default value. Sources are only read the first time the value of
+             * the argument is, and the value is then converted, validated and
+             * passed to the callback of the argument as if it had been parsed.
+             * Only arguments that take input can have other sources.
+             * 
+             * @param {std::string|Token} The name, identifier or token of the argument.
+             * @param {std::string} variable|key|value The name of the environment variable, the key in the configuration file or the default value.
+             * @return {bool} True if the argument was found and takes input. False otherwise.
+             */
+            bool setEnvironment(const std::string& name, const std::string& variable);
+            bool setEnvironment(const Token& token, const std::string& variable);
+            bool setConfigKey(const std::string& name, const std::string& key);
+            bool setConfigKey(const Token& token, const std::string& key);
+            bool setDefault(const std::string& name, const std::string& value);
+            bool setDefault(const Token& token, const std::string& value);
+
+            /**
+             * This method runs every conversion of the last parsed command line
+             * that was deferred by a lazy argument. See ParseResult::forceConversions.
+             */
+            void forceConversions() const;
+
+            /**
+             * This method returns the usage text of the parser, as printed by
+             * autohelper. The text is rendered the first time it is requested
+             * and cached until another argument is registered, so later calls
+             * only return the cached buffer. Arguments are listed in the order
+             * they were registered, and descriptions are wrapped to the width
+             * given.
+             * 
+             * @param {size_t} width The number of columns to wrap to. If 0, the width of the terminal of the standard output, or 80 if it is not a terminal.
+             * @return {shared_ptr<const string>} The usage text. It is never modified, and remains valid after the parser changes.
+             */
+            std::shared_ptr<const std::string> getHelpText(size_t width = 0) const;
+
             /**
              * Calling this method will register the 'h' and 'help' switches under 'help'.
              * 
@@ -251,8 +421,52 @@ namespace ArgsParser
              * This method parses argv.
              * @param {int} argc The argument count.
              * @param {char**} argv The argument vector.
+             * @param {ParseOptions} options The settings to parse with.
+             */
+            void parse(int argc, char* argv[], const ParseOptions& options = ParseOptions());
+
+            /**
+             * This method parses arguments read from a file descriptor, such as
+             * standard input, as they are read. See CompiledSchema::parseStream.
+             * @param {int} fd The file descriptor to read from, until the end of the stream.
+             * @param {char} delimiter The character separating arguments.
+             * @param {ParseOptions} options The settings to parse with.
+             */
+            void parseStream(int fd, char delimiter = '\0', const ParseOptions& options = ParseOptions());
+
+            /**
+             * This method returns the timings and counters recorded by the
+             * last call to parse, when the library is built with
+             * ARGSPARSER_INSTRUMENTATION. See ParseResult::getStatistics.
+             * @return {ParseStatistics} The statistics of the last parse.
+             */
+            ParseStatistics getStatistics() const;
+
+            /**
+             * This method returns the result of the last call to parse.
+             * @return {ParseResult} The state of every argument found in the last parsed command line.
+             */
+            const ParseResult& getResult() const noexcept;
+
+            /**
+             * This method compiles the arguments registered so far into an
+             * immutable schema. The schema is independent from the parser, so
+             * arguments registered afterwards will not be part of it. It
+             * shares the arguments of the parser until the parser is
+             * modified, so compiling does not copy them.
+             * 
+             * Unlike the parser, a compiled schema can parse any number of
+             * command lines and be shared between threads. Each call to parse
+             * on it returns a new ParseResult.
+             * @return {CompiledSchema} The compiled schema.
              */
-            void parse(int argc, char* argv[]);
+            CompiledSchema compile() const;
+
+            /**
+             * This method gets the memory resource the parser allocates from.
+             * @return {memory_resource*} The memory resource of the parser.
+             */
+            std::pmr::memory_resource* getMemoryResource() const noexcept;
 
         private:
             // The following private methods are used to interface with the
@@ -275,13 +489,32 @@ namespace ArgsParser
             void setError(const std::string& message);
 
             /**
-             * This method sets the container represented by a token to active and
-             * optionally assigns it a user input parameter.
+             * This method checks that a name and identifiers are free to be
+             * registered, normalizing the identifiers. Failures are reported
+             * through the return value rather than thrown, so that rejecting
+             * a registration is cheap.
              * 
-             * @param {Token} token The token that identifies the option.
-             * @param {std::string} user_input The user input data.
+             * @param {std::string} name The name to register.
+             * @param {vector<string>} identifiers The identifiers to register.
+             * @param {vector<string>} normalized The vector to store the normalized identifiers in.
+             * @return {std::string} The reason the registration is invalid, or an empty string if it is valid.
              */
-            void setActive(const Token token, const std::string& user_input = nullptr);
+            std::string checkRegistration(
+                const std::string& name,
+                const std::vector<std::string>& identifiers,
+                std::vector<std::string>& normalized
+            ) const;
+
+            /**
+             * This method reports a failed registration. It throws unless the
+             * parser was created with no_except set, in which case it sets the
+             * error description instead.
+             * 
+             * @param {std::string} message The reason the registration failed.
+             * @return {Token} NULL_TOKEN.
+             * @except {std::runtime_error} Registration failure.
+             */
+            Token registrationError(const std::string& message);
     };
 
 
@@ -289,25 +522,37 @@ namespace ArgsParser
 
 
     template <typename T>
-    const TypedValueWrapper<T> Parser::getValue(const std::string& name) const noexcept {
+    TypedValueWrapper<T> Parser::getValue(const std::string& name) const noexcept {
         return getValue<T>(isRegistered(name));
     };
 
     template <typename T>
-    const TypedValueWrapper<T> Parser::getValue(const Token& token) const noexcept {
-        try {
-            const TypedInputContainer<T>* container = dynamic_cast<const TypedInputContainer<T>*>(getContainer(token));
-            if (container == nullptr) throw std::invalid_argument(
-                std::string("Identifier does not refer to a registered container of type ") + typeid(T).name());
-            return container->getConvertedValue();
-        }
-        catch (const std::exception&) {
-            return TypedValueWrapper<T>();
-        }
+    TypedValueWrapper<T> Parser::getValue(const Token& token) const noexcept {
+        return getResult().getValue<T>(token);
     };
 
     template <typename T>
-    Token Parser::registerPositional(
+    TypedValueWrapper<T> Parser::getValue(const TypedToken<T>& token) const noexcept {
+        return getResult().getValue(token);
+    };
+
+    template <typename T>
+    Span<T> Parser::getValueView(const std::string& name) const noexcept {
+        return getValueView<T>(isRegistered(name));
+    };
+
+    template <typename T>
+    Span<T> Parser::getValueView(const Token& token) const noexcept {
+        return getResult().getValueView<T>(token);
+    };
+
+    template <typename T>
+    Span<T> Parser::getValueView(const TypedToken<T>& token) const noexcept {
+        return getResult().getValueView(token);
+    };
+
+    template <typename T>
+    TypedToken<T> Parser::registerPositional(
         const std::string& name,
         const std::string& placeholder_text,
         const Callback& callback,
@@ -315,40 +560,32 @@ namespace ArgsParser
         const Validator<T>& validator,
         const ErrorHandler& error_callback
     ){
-        try{
-            // First check if name is already registered.
-            if(isNameRegistered(name))
-                throw std::runtime_error("Name \"" + name + "\" is already registered.");
-
-            TypedInputContainer<T>* container = new TypedInputContainer<T>(
-                ArgType::Positional,
-                name,
-                std::vector<std::string>(),
-                "",
-                placeholder_text,
-                1,
-                converter,
-                validator,
-                error_callback,
-                callback
-            );
-
-            Token id = registerContainer(ArgType::Positional, container);
-
-            return id;
-        }
-        catch (const std::exception& e){
-            std::string error_string = std::string("Registration Error: ") + e.what();
-
-            if(!no_except_) throw std::runtime_error(error_string);
-            else setError(error_string);
-
-            return NULL_TOKEN;
-        }
+        // First check if name is already registered.
+        std::vector<std::string> identifiers_;
+        std::string error = checkRegistration(name, std::vector<std::string>(), identifiers_);
+        if (!error.empty()) return TypedToken<T>(registrationError(error));
+
+        TypedInputContainer<T>* container = create<TypedInputContainer<T>>(
+            getMemoryResource(),
+            ArgType::Positional,
+            name,
+            identifiers_,
+            "",
+            placeholder_text,
+            1,
+            converter,
+            validator,
+            error_callback,
+            callback
+        );
+
+        TypedToken<T> id(registerContainer(ArgType::Positional, container));
+
+        return id;
     };
 
     template <typename T>
-    Token Parser::registerOption(
+    TypedToken<T> Parser::registerOption(
         const std::string& name,
         const std::vector<std::string>& identifiers,
         const std::string& placeholder_text,
@@ -359,45 +596,29 @@ namespace ArgsParser
         const Validator<T>& validator,
         const ErrorHandler& error_callback
     ){
-        try{
-            // First check if all identifiers are open to be registered.
-            if(isNameRegistered(name)) 
-                throw std::runtime_error( "Name \"" + name + "\" is already registered." );
-
-            std::vector<std::string> identifiers_(identifiers.size());
-            for(size_t i = 0; i < identifiers.size(); i++)
-            {
-                identifiers_[i] = ArgsTools::make_identifier(identifiers[i]);
-                if(isIdentifierRegistered(identifiers_[i]))
-                    throw std::runtime_error( "Identifier \"" + identifiers_[i] + "\" is already registered." );
-            }
-        
-            // If check was successful, create a new container object.
-            TypedInputContainer<T>* container = new TypedInputContainer<T>(
-                ArgType::Option,
-                name,
-                identifiers_,
-                description,
-                placeholder_text,
-                max_values,
-                converter,
-                validator,
-                error_callback,
-                callback
-            );
-
-            // And push the container to the array of registered options.
-            Token id = registerContainer(ArgType::Option, container);
-
-            return id;
-        }
-        catch (const std::exception& e) {
-            std::string error_string = std::string("Registration Error: ") + e.what();
-
-            if(!no_except_) throw std::runtime_error(error_string);
-            else setError(error_string);
-
-            return NULL_TOKEN;
-        }
+        // First check if all identifiers are open to be registered.
+        std::vector<std::string> identifiers_;
+        std::string error = checkRegistration(name, identifiers, identifiers_);
+        if (!error.empty()) return TypedToken<T>(registrationError(error));
+
+        // If check was successful, create a new container object.
+        TypedInputContainer<T>* container = create<TypedInputContainer<T>>(
+            getMemoryResource(),
+            ArgType::Option,
+            name,
+            identifiers_,
+            description,
+            placeholder_text,
+            max_values,
+            converter,
+            validator,
+            error_callback,
+            callback
+        );
+
+        // And push the container to the array of registered options.
+        TypedToken<T> id(registerContainer(ArgType::Option, container));
+
+        return id;
     };
 }
\ No newline at end of file
@@ -7,47 +7,41 @@
  */
 
 #include <argsparser/parser.h>
+#include <argsparser/schemaImpl.h>
 
 namespace ArgsParser
 {
     struct Parser::ParserImpl{
-        // This string stores the parsed name of the program.
-        std::string program_name;
-
         // This short stores the code of the last non-critical error.
         unsigned short error_code;
         // This string stores the description of the last non-critical error.
         std::string error_description;
 
-        /**
-         * These maps stores name and symbol information respectively. The name
-         * map maps user entered names (such as "help") to the respective type
-         * of argument and identifier so it may be quickly accessed from the
-         * corresponding vector, while the symbol maps map command line symbols
-         * (such as "-h") for access when parsing the command line.
-         */
-        std::unordered_map<std::string, Token> names;
-        std::unordered_map<std::string, Token> identifiers;
+        // The schema built by the registration methods. It is shared with
+        // copies of the parser and with the schemas and results obtained from
+        // it, and copied by mutableSchema() before being modified.
+        std::shared_ptr<SchemaImpl> schema;
 
-        /**
-         * These vectors contain pointers to the actual containers storing each
-         * argument type.
-         * Positionals are read in the order they are declared, so this vector
-         * can be used to retrieve their containers faster than a map lookup.
-         */
-        std::vector<Container*> registered_positionals;
-        std::vector<Container*> registered_switches;
-        std::vector<Container*> registered_options;
+        // The result of the last call to parse.
+        ParseResult result;
 
-        ParserImpl();
+        explicit ParserImpl(std::pmr::memory_resource* resource = nullptr);
+        explicit ParserImpl(const std::shared_ptr<SchemaImpl>& schema);
 
-        ~ParserImpl();
+        /**
+         * This method returns the schema for modification. If the schema is
+         * shared, it is first deep copied into the memory resource it was
+         * allocated from, so that other holders are not affected.
+         * @return {SchemaImpl&} The schema, owned only by this parser.
+         */
+        SchemaImpl& mutableSchema();
 
         /**
-         * This method gets a registered container by it's token.
-         * @param {Token} The registration token.
-         * @return {Container*} The container.
+         * This method returns the container of an argument that takes input
+         * for modification, copying the schema first if it is shared.
+         * @param {Token} token The token of the argument.
+         * @return {InputContainer*} The container, or nullptr if the argument is not registered or takes no input.
          */
-        Container* getContainer(const Token& token);
+        InputContainer* mutableInput(const Token& token);
     };
 }
\ No newline at end of file
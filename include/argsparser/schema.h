@@ -0,0 +1,248 @@
+/**
+ * schema.h
+ * 
+ * This file contains the declaration of the CompiledSchema class, an immutable
+ * snapshot of the arguments registered to a Parser.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <argsparser/token.h>
+#include <argsparser/container.h>
+
+namespace ArgsParser
+{
+    struct SchemaImpl;
+    class ParseResult;
+    class ThreadPool;
+
+    /**
+     * This is the declaration of a value sink function.
+     * 
+     * A value sink is called with each value read by the parser, along with
+     * the token of the argument it was read for, before the value is stored.
+     * If it returns true the value is consumed: it is not stored in the parse
+     * result, and the view passed is only valid during the call. This keeps
+     * memory bounded when an argument takes an unbounded number of values,
+     * such as a list of files read from a stream.
+     * 
+     * Consumed values do not count towards the maximum number of values of
+     * an option, and are neither converted nor validated.
+     */
+    using ValueSink = std::function<bool(const Token&, std::string_view)>;
+
+    /**
+     * This struct holds settings that apply to a single call to parse.
+     */
+    struct ParseOptions
+    {
+        /**
+         * Whether user input should be stored as views into argv rather than
+         * copied. This removes every per-argument copy from the parse, but
+         * argv must then outlive the parse result (as the one passed to main
+         * does).
+         */
+        bool zero_copy = false;
+
+        /**
+         * The memory resource to allocate the parse result from, including
+         * the state and values of every argument and the copy of argv. The
+         * default memory resource is used if none is given. The resource must
+         * outlive the result and any copy of it. parseBatch parses every line
+         * with the same options on several threads at once, so a resource
+         * given to it must be thread safe, such as a
+         * synchronized_pool_resource, and not a monotonic_buffer_resource.
+         */
+        std::pmr::memory_resource* resource = nullptr;
+
+        /**
+         * Whether arguments of the form "@path" should be replaced by the
+         * arguments read from the response file at path. Arguments in the
+         * file are separated by whitespace, which may be kept within an
+         * argument by quoting it with single or double quotes. A backslash
+         * includes the next character as is. The file is mapped into memory
+         * and values refer to it directly, so it is never copied.
+         */
+        bool expand_response_files = false;
+
+        /**
+         * A function to pass every value to as it is read, which may consume
+         * it instead of having it stored. See ValueSink.
+         */
+        ValueSink value_sink = nullptr;
+
+        /**
+         * Whether an identifier that is not registered may match one it is
+         * the start of, in the manner of GNU long options, so that "--verb"
+         * is read as "--verbose". An abbreviation must start with two
+         * dashes and be at least two characters long, and must only be the
+         * start of identifiers of a single argument. Arguments starting with
+         * a single dash are split into bundled switches instead.
+         */
+        bool allow_abbreviations = false;
+
+        /**
+         * Whether an identifier that is not registered should stop parsing
+         * with an error naming the closest registered identifiers, rather
+         * than be ignored.
+         */
+        bool reject_unknown = false;
+
+        /**
+         * The path of a configuration file to read the values of arguments
+         * missing from the command line from, by the keys set with
+         * Parser::setConfigKey. See ConfigFile for its format. The file is
+         * mapped into memory by the parse, but only read once a value is.
+         */
+        std::string config_file;
+
+        /**
+         * A thread pool to convert and validate the values of arguments on
+         * once the command line is read, or none to do so on the thread
+         * parsing. Arguments are processed at once, and the values of an
+         * argument taking many are split into parts of at most part_size
+         * values processed at once as well, so converters and validators
+         * must be safe to call from several threads. Callbacks and error
+         * callbacks are still called from the thread parsing, in the order
+         * the arguments were found, once every value has been processed.
+         * 
+         * Unlike a sequential parse, values following a rejected value may
+         * still be converted and validated, although they are not kept. A
+         * parse run from a task of the same pool, such as by parseBatch on
+         * it, processes its arguments on its own thread.
+         */
+        ThreadPool* pool = nullptr;
+        size_t part_size = 256;
+    };
+
+    /**
+     * This class holds the set of arguments registered to a parser in a form
+     * that can no longer be modified. It is obtained by calling compile() on a
+     * Parser once all arguments have been registered.
+     * 
+     * A compiled schema does not store any parse state. Every call to parse()
+     * produces an independent ParseResult, so a single schema can be used to
+     * parse any number of command lines and may be shared between threads.
+     * Copies of a compiled schema share the same underlying data.
+     */
+    class CompiledSchema{
+        std::shared_ptr<const SchemaImpl> schema_impl;
+
+        public:
+            CompiledSchema();
+            explicit CompiledSchema(const std::shared_ptr<const SchemaImpl>& schema);
+
+            /**
+             * This method returns whether a name or identifier is registered to
+             * the schema.
+             * @param {std::string} symbol The symbol to search for.
+             * @return {Token} The token of the symbol if registered. NULL_TOKEN otherwise.
+             */
+            Token isRegistered(const std::string& symbol) const noexcept;
+
+            /**
+             * This method returns whether a name is registered to the schema.
+             * @param {std::string} name The name to search for.
+             * @return {Token} The token of the name if registered. NULL_TOKEN otherwise.
+             */
+            Token isNameRegistered(const std::string& name) const noexcept;
+
+            /**
+             * This method returns whether an identifier is registered to the
+             * schema. Identifiers are resolved through a perfect hash table, so
+             * looking up a null terminated string such as an argv entry does
+             * not allocate.
+             * @param {std::string} identifier The identifier to search for.
+             * @return {Token} The token of the identifier if registered. NULL_TOKEN otherwise.
+             */
+            Token isIdentifierRegistered(const std::string& identifier) const noexcept;
+            Token isIdentifierRegistered(const char* identifier) const noexcept;
+
+            /**
+             * This method returns the argument an identifier or an
+             * unambiguous abbreviation of one refers to. See
+             * ParseOptions::allow_abbreviations.
+             * @param {std::string} identifier The identifier or abbreviation to search for.
+             * @return {Token} The token of the argument if found. NULL_TOKEN otherwise.
+             */
+            Token matchIdentifier(const std::string& identifier) const noexcept;
+
+            /**
+             * This method returns the registered identifiers closest to a
+             * string, such as a mistyped identifier, nearest first. Distance
+             * is counted in characters inserted, removed, replaced or swapped.
+             * @param {std::string} identifier The string to find identifiers close to.
+             * @param {size_t} max_distance The largest distance of an identifier to return.
+             * @param {size_t} max_results The largest number of identifiers to return.
+             * @return {std::vector<std::string>} The closest identifiers.
+             */
+            std::vector<std::string> suggestIdentifiers(const std::string& identifier, size_t max_distance = 2, size_t max_results = 3) const;
+
+            /**
+             * This method returns a vector of all tokens in the schema.
+             * @return {std::vector<Token>} The list of registered tokens.
+             */
+            std::vector<Token> getRegisteredTokens() const;
+
+            /**
+             * This method returns a vector of all names in the schema.
+             * @return {std::vector<std::string>} The list of registered names.
+             */
+            std::vector<std::string> getRegisteredNames() const;
+
+            /**
+             * This method gets a registered container by it's name or token.
+             * @param {Token} The registration token.
+             * @return {Container*} The container, or nullptr if not registered.
+             */
+            const Container* getContainer(const std::string& name) const noexcept;
+            const Container* getContainer(const Token& token) const noexcept;
+
+            /**
+             * This method gets the program name set by the user when the schema
+             * was compiled. It is empty if the name was left to be parsed from
+             * the command line.
+             * @return {std::string} The name of the program.
+             */
+            std::string getProgramName() const noexcept;
+
+            /**
+             * This method parses argv into a new ParseResult. The schema itself
+             * is not modified.
+             * @param {int} argc The argument count.
+             * @param {char**} argv The argument vector.
+             * @param {ParseOptions} options The settings to parse with.
+             * @return {ParseResult} The state of every argument found in argv.
+             */
+            ParseResult parse(int argc, char* argv[], const ParseOptions& options = ParseOptions()) const;
+
+            /**
+             * This method parses arguments read from a file descriptor, such as
+             * standard input, into a new ParseResult. Arguments are separated by
+             * a delimiter (a NUL character, as written by "find -print0", or a
+             * newline) and are parsed as they are read, so the stream is never
+             * held in memory as a whole. The stream holds arguments only, not
+             * the program name.
+             * 
+             * Values stored in the result are kept in the blocks they were
+             * read into, while blocks holding no stored value are reused. Used
+             * with ParseOptions::value_sink, memory stays bounded however long
+             * the stream is.
+             * @param {int} fd The file descriptor to read from, until the end of the stream.
+             * @param {char} delimiter The character separating arguments. When it is a newline, a preceding carriage return is also removed.
+             * @param {ParseOptions} options The settings to parse with.
+             * @return {ParseResult} The state of every argument found in the stream.
+             * @except {std::runtime_error} The stream could not be read, or the arguments could not be parsed.
+             */
+            ParseResult parseStream(int fd, char delimiter = '\0', const ParseOptions& options = ParseOptions()) const;
+
+        private:
+            friend class Parser;
+            friend class ParseResult;
+
+            const SchemaImpl* get() const noexcept;
+    };
+}
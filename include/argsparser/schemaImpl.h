@@ -0,0 +1,315 @@
+/**
+ * schemaImpl.h
+ * 
+ * This file contains the declarations of the internals of the CompiledSchema
+ * class, shared with the Parser class that builds it.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <argsparser/config_file.h>
+#include <argsparser/identifier_table.h>
+#include <argsparser/identifier_trie.h>
+#include <argsparser/parse_result.h>
+#include <argsparser/util.h>
+
+namespace ArgsParser
+{
+    struct SchemaImpl{
+        // The memory resource the containers and lookup structures of the
+        // schema are allocated from.
+        std::pmr::memory_resource* resource;
+
+        // This string stores the program name set by the user, if any.
+        std::string program_name;
+
+        /**
+         * These maps stores name and symbol information respectively. The name
+         * map maps user entered names (such as "help") to the respective type
+         * of argument and identifier so it may be quickly accessed from the
+         * corresponding vector, while the symbol maps map command line symbols
+         * (such as "-h") for access when parsing the command line.
+         * Keys refer to the strings owned by the registered containers.
+         */
+        std::pmr::unordered_map<std::string_view, Token> names;
+        std::pmr::unordered_map<std::string_view, Token> identifiers;
+
+        /**
+         * These vectors contain pointers to the actual containers storing each
+         * argument type.
+         * Positionals are read in the order they are declared, so this vector
+         * can be used to retrieve their containers faster than a map lookup.
+         */
+        std::pmr::vector<Container*> registered_positionals;
+        std::pmr::vector<Container*> registered_switches;
+        std::pmr::vector<Container*> registered_options;
+
+        /**
+         * This table resolves command line identifiers to tokens while parsing.
+         * It is built from the identifier map by freeze(), and is only valid
+         * while frozen is set.
+         * 
+         * The trie holds the same identifiers, and is used to resolve
+         * abbreviations and suggest identifiers when the table has no match.
+         * 
+         * A schema may be shared by several parsers and compiled schemas, any
+         * of which may freeze it, so both are built under freeze_mutex.
+         */
+        mutable IdentifierTable lookup_table;
+        mutable IdentifierTrie identifier_trie;
+        mutable std::atomic<bool> frozen;
+        mutable std::mutex freeze_mutex;
+
+        /**
+         * The usage text of the schema, rendered the first time it is
+         * requested and kept until an argument is registered. It is rendered
+         * for a single program name and terminal width at a time, under
+         * help_mutex.
+         */
+        mutable std::shared_ptr<const std::string> help_text;
+        mutable std::string help_program_name;
+        mutable size_t help_width;
+        mutable std::mutex help_mutex;
+
+        // Whether any argument may take its value from a source other than
+        // the command line. See InputContainer::hasFallback.
+        bool has_fallbacks;
+
+        // Whether any argument has a validator returning a future, so that
+        // every argument must be validated before any is awaited.
+        bool has_async_validators;
+
+        explicit SchemaImpl(std::pmr::memory_resource* resource = nullptr);
+        SchemaImpl(const SchemaImpl& other);    // Deep copy of every container.
+        ~SchemaImpl();
+
+        /**
+         * This method adds the name and identifiers of a registered container
+         * to the maps.
+         * @param {Token} token The registration token of the container.
+         * @param {Container*} container The container.
+         */
+        void index(const Token& token, const Container* container);
+
+        /**
+         * This method gets a registered container by it's token.
+         * @param {Token} The registration token.
+         * @return {Container*} The container, or nullptr if not registered.
+         */
+        Container* getContainer(const Token& token) const noexcept;
+
+        /**
+         * These methods look up a name or a complete identifier (such as
+         * "--help") in the respective map.
+         * @param {string_view} key The name or identifier to search for.
+         * @return {Token} The token if registered. NULL_TOKEN otherwise.
+         */
+        Token findName(std::string_view name) const noexcept;
+        Token findIdentifier(std::string_view identifier) const noexcept;
+
+        /**
+         * This method builds the lookup structures used while parsing from the
+         * arguments registered so far, unless they are built already. It must
+         * be called again after any further registration. It may be called
+         * from several threads at once.
+         */
+        void freeze() const;
+
+        /**
+         * These methods resolve an identifier or an abbreviation of one, and
+         * describe an identifier that is not registered, suggesting the
+         * closest ones. The schema must be frozen.
+         * @param {std::string_view} identifier The identifier.
+         * @return {Token|std::string} The token of the argument if found, or the description of the error.
+         */
+        Token matchIdentifier(std::string_view identifier) const noexcept;
+        std::string unknownIdentifierError(std::string_view identifier) const;
+
+        /**
+         * This method returns the usage text of the schema, rendering it only
+         * if the cached text was rendered for another program name or width.
+         * It may be called from several threads at once.
+         * @param {std::string_view} program_name The name of the program to show.
+         * @param {size_t} width The number of columns to wrap the text to.
+         * @return {shared_ptr<const string>} The usage text.
+         */
+        std::shared_ptr<const std::string> getHelpText(std::string_view program_name, size_t width) const;
+
+        /**
+         * This method parses argv, storing the state of every argument found
+         * into the result provided and running post-processing on them.
+         * @param {int} argc The argument count.
+         * @param {char**} argv The argument vector.
+         * @param {ParseResult} result The result to store parse state in.
+         * @param {ParseOptions} options The settings to parse with.
+         */
+        void parse(int argc, char* argv[], ParseResult& result, const ParseOptions& options) const;
+
+        /**
+         * This method parses the arguments read from a file descriptor,
+         * storing the state of every argument found into the result provided
+         * and running post-processing on them.
+         * @param {int} fd The file descriptor to read from.
+         * @param {char} delimiter The character separating arguments.
+         * @param {ParseResult} result The result to store parse state in.
+         * @param {ParseOptions} options The settings to parse with.
+         */
+        void parseStream(int fd, char delimiter, ParseResult& result, const ParseOptions& options) const;
+
+        /**
+         * This struct holds the position of the parser within a command line,
+         * so that the command line can be read one token at a time.
+         */
+        struct Cursor{
+            ParseResult& result;
+            const ParseOptions& options;
+
+            // The containers activated so far, in the order they were found.
+            std::vector<std::pair<const Container*, ContainerState*>> active;
+
+            // The container the next value is appended to, if any.
+            const InputContainer* container;
+            InputState* state;
+            Token token;
+
+            // The number of positionals read so far.
+            size_t positional;
+
+            // The number of response files currently being expanded.
+            unsigned depth;
+
+            // Whether a value has been stored since this was last cleared,
+            // meaning the buffer it was read from must be kept.
+            bool retained;
+
+            Cursor(ParseResult& result, const ParseOptions& options);
+        };
+
+        /**
+         * This method reads the next token of a command line. The token must
+         * remain valid for as long as the result.
+         * @param {Cursor} cursor The position of the parser.
+         * @param {std::string_view} token The token.
+         */
+        void consume(Cursor& cursor, std::string_view token) const;
+
+        /**
+         * This method resolves an identifier to the token of its argument,
+         * matching abbreviations if the options of the parse allow them.
+         * @param {Cursor} cursor The position of the parser.
+         * @param {char*} identifier The identifier.
+         * @param {size_t} length The length of the identifier.
+         * @return {Token} The token of the argument, or NULL_TOKEN if there is none.
+         */
+        Token lookup(Cursor& cursor, const char* identifier, size_t length) const;
+
+        /**
+         * This method reads a token starting with a dash that is not itself
+         * an identifier, splitting it into the arguments it joins: a long
+         * option and its value separated by '=', or short switches bundled
+         * together, the last of which may be an option followed by its value.
+         * Values are views into the token, so nothing is allocated.
+         * @param {Cursor} cursor The position of the parser.
+         * @param {std::string_view} token The token.
+         * @return {bool} Whether the token was split into known arguments.
+         */
+        bool split(Cursor& cursor, std::string_view token) const;
+
+        /**
+         * This method sets the argument of a token active, and loads it to
+         * receive the values that follow if it takes any.
+         * @param {Cursor} cursor The position of the parser.
+         * @param {Token} token The token of the argument.
+         */
+        void select(Cursor& cursor, Token token) const;
+
+        /**
+         * This method appends a value to the argument currently loaded, if
+         * there is one.
+         * @param {Cursor} cursor The position of the parser.
+         * @param {std::string_view} value The value.
+         */
+        void append(Cursor& cursor, std::string_view value) const;
+
+        /**
+         * This method reads every token of a response file, as if they had
+         * been given in its place. The file is mapped into memory and owned by
+         * the result, and values refer to it directly.
+         * @param {Cursor} cursor The position of the parser.
+         * @param {std::string_view} path The path of the response file.
+         */
+        void expand(Cursor& cursor, std::string_view path) const;
+
+        /**
+         * This method runs post-processing on every argument found, once the
+         * whole command line has been read.
+         * @param {Cursor} cursor The position of the parser.
+         */
+        void finish(Cursor& cursor) const;
+
+        /**
+         * This method runs post-processing on every argument found in two
+         * passes, converting and validating the parts of every argument,
+         * on a thread pool if one is given, before awaiting asynchronous
+         * validations and calling callbacks in order.
+         * @param {Cursor} cursor The position of the parser.
+         * @param {ThreadPool*} pool The pool to run conversion and validation on, or nullptr to run them on this thread.
+         */
+        void postProcess(Cursor& cursor, ThreadPool* pool) const;
+
+        /**
+         * This method creates the state of an argument that was not found in
+         * the command line from the first of its other sources to have a
+         * value: the environment, the configuration file, then its default.
+         * The state is post-processed as if the value had been parsed.
+         * 
+         * It runs on whichever thread first reads the argument, so the state
+         * and the copy of an environment value are allocated from the
+         * default heap rather than the resource of the result. The state is
+         * stored before it is post-processed, so that its callbacks may read
+         * it. An exception thrown while post-processing rejects the value,
+         * as for a lazy argument. See TypedInputState::forceConversion.
+         * @param {Token} token The token of the argument.
+         * @param {ConfigFile*} config The configuration file, if any.
+         * @param {StatePointer} state Set to the state, or left null if no source has a value.
+         * @param {shared_ptr<const char>} buffer Set to the copy of the environment value the state refers to, if any.
+         */
+        void fallback(const Token& token, const ConfigFile* config, StatePointer& state,
+                      std::shared_ptr<const char>& buffer) const noexcept;
+    };
+
+    /**
+     * This struct holds the states a result reads from sources other than
+     * the command line. They are created the first time they are read, and
+     * are shared by copies of the result.
+     */
+    struct ParseResult::Fallbacks{
+        // The state of a single argument. Each is resolved under its own
+        // mutex, so that reading one argument never waits on another, and
+        // the mutex is recursive so that its callbacks may read it again.
+        struct Slot{
+            std::recursive_mutex mutex;
+            std::atomic<bool> resolved{false};
+            bool resolving = false;
+            StatePointer state;
+
+            // The copy of the environment value the state refers to, if any.
+            std::shared_ptr<const char> buffer;
+        };
+
+        Fallbacks(size_t positionals, size_t options) :
+            slots{std::vector<Slot>(positionals), std::vector<Slot>(options)}
+            { };
+
+        std::shared_ptr<const ConfigFile> config;
+
+        // The states by position, for positionals and options respectively.
+        std::vector<Slot> slots[2];
+    };
+}
@@ -0,0 +1,46 @@
+/**
+ * span.h
+ * 
+ * This file contains the definition of the Span template, a read-only view
+ * over a contiguous sequence of values owned by a parse result.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace ArgsParser
+{
+    /**
+     * This class refers to a contiguous sequence of values without owning
+     * them. It is returned by accessors that expose values stored in a parse
+     * result without copying them, and is only valid while that result is
+     * alive and unmodified.
+     */
+    template <typename T>
+    class Span
+    {
+        public:
+            typedef const T* iterator;
+
+            Span() noexcept : data_(nullptr), size_(0) { };
+            Span(const T* data, size_t size) noexcept : data_(data), size_(size) { };
+
+            const T* data() const noexcept { return data_; };
+            size_t size() const noexcept { return size_; };
+            bool empty() const noexcept { return size_ == 0; };
+
+            iterator begin() const noexcept { return data_; };
+            iterator end() const noexcept { return data_ + size_; };
+
+            const T& operator[](size_t position) const noexcept { return data_[position]; };
+            const T& front() const noexcept { return data_[0]; };
+            const T& back() const noexcept { return data_[size_ - 1]; };
+
+        private:
+            const T* data_;
+            size_t size_;
+    };
+}
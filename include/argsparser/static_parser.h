@@ -0,0 +1,603 @@
+/**
+ * static_parser.h
+ *
+ * This file contains the declaration of the StaticParser class, a parser
+ * generated at compile time from a fixed set of arguments.
+ *
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <argsparser/converters.h>
+#include <argsparser/identifier_table.h>
+#include <argsparser/span.h>
+
+namespace ArgsParser
+{
+    // The maximum number of identifiers of an argument of a static schema.
+    const size_t MAX_STATIC_IDENTIFIERS = 4;
+
+    /**
+     * This struct describes an argument of a static schema. It is created at
+     * compile time by staticSwitch, staticPositional or staticOption.
+     */
+    struct StaticArgument
+    {
+        ArgType type = ArgType::Null;
+        std::string_view name;
+        std::string_view identifiers[MAX_STATIC_IDENTIFIERS] = {};
+        size_t identifier_count = 0;
+        size_t max_values = 0;
+    };
+
+    namespace Detail
+    {
+        constexpr StaticArgument makeStaticArgument(
+            ArgType type,
+            std::string_view name,
+            std::initializer_list<std::string_view> identifiers,
+            size_t max_values
+        ){
+            if (identifiers.size() > MAX_STATIC_IDENTIFIERS)
+                throw std::length_error("Too many identifiers for a static argument.");
+
+            StaticArgument argument{};
+            argument.type = type;
+            argument.name = name;
+            for (std::string_view identifier : identifiers) argument.identifiers[argument.identifier_count++] = identifier;
+            argument.max_values = max_values;
+            return argument;
+        }
+
+        // Returns an identifier without its prefixing dashes, as stored in an
+        // IdentifierTable.
+        constexpr std::string_view stripDashes(std::string_view identifier) noexcept{
+            size_t first_char = identifier.find_first_not_of('-');
+            return first_char == std::string_view::npos? std::string_view() : identifier.substr(first_char);
+        }
+
+        // Whether a string can be made into an identifier, following the
+        // rules of ArgsTools::check_identifier: only letters and dashes, at
+        // least one letter, and no trailing dash.
+        constexpr bool isValidStaticIdentifier(std::string_view identifier) noexcept{
+            if (identifier.empty() || identifier.back() == '-') return false;
+            for (char character : identifier) {
+                if (character != '-' && !(character >= 'a' && character <= 'z') && !(character >= 'A' && character <= 'Z'))
+                    return false;
+            }
+            return true;
+        }
+
+        template <size_t N>
+        constexpr bool staticArgumentsAreComplete(const StaticArgument (&arguments)[N]) noexcept{
+            for (size_t i = 0; i < N; i++) {
+                if (arguments[i].type == ArgType::Null) return false;
+                if (arguments[i].type == ArgType::Option && arguments[i].max_values == 0) return false;
+            }
+            return true;
+        }
+
+        template <size_t N>
+        constexpr bool staticNamesAreUnique(const StaticArgument (&arguments)[N]) noexcept{
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = i + 1; j < N; j++) {
+                    if (arguments[i].name == arguments[j].name) return false;
+                }
+            }
+            return true;
+        }
+
+        template <size_t N>
+        constexpr bool staticIdentifiersAreValid(const StaticArgument (&arguments)[N]) noexcept{
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = 0; j < arguments[i].identifier_count; j++) {
+                    if (!isValidStaticIdentifier(arguments[i].identifiers[j])) return false;
+                }
+            }
+            return true;
+        }
+
+        // Identifiers are compared without their dashes, so "-v" and "--v"
+        // collide as they would in a Parser.
+        template <size_t N>
+        constexpr bool staticIdentifiersAreUnique(const StaticArgument (&arguments)[N]) noexcept{
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = 0; j < arguments[i].identifier_count; j++) {
+                    std::string_view key = stripDashes(arguments[i].identifiers[j]);
+                    for (size_t k = i; k < N; k++) {
+                        for (size_t l = (k == i? j + 1 : 0); l < arguments[k].identifier_count; l++) {
+                            if (stripDashes(arguments[k].identifiers[l]) == key) return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        template <size_t N>
+        constexpr size_t countStaticIdentifiers(const StaticArgument (&arguments)[N]) noexcept{
+            size_t count = 0;
+            for (size_t i = 0; i < N; i++) count += arguments[i].identifier_count;
+            return count;
+        }
+
+        template <size_t N>
+        constexpr size_t countStaticPositionals(const StaticArgument (&arguments)[N]) noexcept{
+            size_t count = 0;
+            for (size_t i = 0; i < N; i++) count += arguments[i].type == ArgType::Positional;
+            return count;
+        }
+
+        // Returns the offset of the values of each argument in the storage of
+        // a static parse result, followed by the size of the storage.
+        // Positionals hold one value and options up to their maximum.
+        template <size_t N>
+        constexpr std::array<size_t, N + 1> staticValueOffsets(const StaticArgument (&arguments)[N]) noexcept{
+            std::array<size_t, N + 1> offsets{};
+            for (size_t i = 0; i < N; i++) {
+                size_t values = arguments[i].type == ArgType::Positional? 1 : arguments[i].type == ArgType::Option? arguments[i].max_values : 0;
+                offsets[i + 1] = offsets[i] + values;
+            }
+            return offsets;
+        }
+
+        // Returns the index of every positional, in the order they are parsed.
+        template <size_t Count, size_t N>
+        constexpr std::array<size_t, Count> staticPositionals(const StaticArgument (&arguments)[N]) noexcept{
+            std::array<size_t, Count> positionals{};
+            size_t count = 0;
+            for (size_t i = 0; i < N; i++) {
+                if (arguments[i].type == ArgType::Positional) positionals[count++] = i;
+            }
+            return positionals;
+        }
+    }
+
+    /**
+     * These methods describe the arguments of a static schema, mirroring the
+     * registration methods of Parser. Identifiers follow the same rules, and
+     * may be given with or without their prefixing dashes.
+     *
+     * @param {std::string_view} name The name of the argument.
+     * @param {initializer_list<std::string_view>} identifiers The identifiers of the argument, at most MAX_STATIC_IDENTIFIERS.
+     * @param {size_t} max_values The maximum number of values the option can hold.
+     * @return {StaticArgument} The description of the argument.
+     */
+    constexpr StaticArgument staticSwitch(std::string_view name, std::initializer_list<std::string_view> identifiers){
+        return Detail::makeStaticArgument(ArgType::Switch, name, identifiers, 0);
+    }
+
+    constexpr StaticArgument staticPositional(std::string_view name){
+        return Detail::makeStaticArgument(ArgType::Positional, name, {}, 1);
+    }
+
+    constexpr StaticArgument staticOption(std::string_view name, std::initializer_list<std::string_view> identifiers, size_t max_values = 1){
+        return Detail::makeStaticArgument(ArgType::Option, name, identifiers, max_values);
+    }
+
+    /**
+     * This class maps the identifiers of a static schema to the index of
+     * their argument. It uses the same hash and displace method as
+     * IdentifierTable, but is built at compile time, and holds no pointers
+     * other than to the identifiers themselves.
+     */
+    template <size_t Count>
+    class StaticIdentifierTable{
+        public:
+            static constexpr size_t NOT_FOUND = (size_t)-1;
+
+            /**
+             * This method builds the table from the arguments of a static
+             * schema, which must hold Count identifiers, all unique once
+             * stripped of their dashes.
+             *
+             * @param {StaticArgument[]} arguments The arguments of the schema.
+             * @return {StaticIdentifierTable} The table, or an empty table if the identifiers are not unique.
+             */
+            template <size_t N>
+            static constexpr StaticIdentifierTable<Count> build(const StaticArgument (&arguments)[N]) noexcept;
+
+            /**
+             * This method looks up an identifier in the table. Prefixing
+             * dashes are ignored.
+             *
+             * @param {std::string_view} identifier The identifier.
+             * @return {size_t} The index of the argument of the identifier if found. NOT_FOUND otherwise.
+             */
+            constexpr size_t find(std::string_view identifier) const noexcept;
+
+        private:
+            struct Entry{
+                std::string_view key;
+                size_t argument = NOT_FOUND;
+            };
+
+            std::array<Entry, Count> entries_{};
+            // The displacement of each bucket. Negative values point directly
+            // to a slot (-value-1), positive values are hash seeds.
+            std::array<int32_t, (Count > 0? Count : 1)> displacements_{};
+    };
+
+    template <const auto& Arguments> class StaticParseResult;
+
+    /**
+     * This class is a parser generated at compile time from a fixed array of
+     * arguments. Usage example:
+     *      static constexpr ArgsParser::StaticArgument arguments[] = {
+     *          ArgsParser::staticSwitch("verbose", {"v", "verbose"}),
+     *          ArgsParser::staticOption("jobs", {"j", "jobs"}),
+     *          ArgsParser::staticPositional("input"),
+     *      };
+     *      using ToolParser = ArgsParser::StaticParser<arguments>;
+     *
+     *      ArgsParser::StaticParseResult<arguments> result = ToolParser::parse(argc, argv);
+     *      int jobs = result.getValue<int>(ToolParser::indexOf("jobs")).value();
+     *
+     * Identifiers are validated and checked for duplicates at compile time,
+     * and the identifier table is built at compile time as well, so there is
+     * nothing to register or build when the program starts. Parsing follows
+     * the basic rules of Parser, but never allocates: values are views into
+     * argv, stored in the result itself. argv must therefore outlive the
+     * result. Response files, value sinks and post-processing are not
+     * supported, and neither are abbreviations, bundled switches such as
+     * -abc or values joined to their identifier such as -j8 or --jobs=8:
+     * every identifier must be given whole, and apart from its values.
+     */
+    template <const auto& Arguments>
+    class StaticParser{
+        static_assert(std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(Arguments[0])>>, StaticArgument>,
+            "A static parser must be generated from an array of StaticArgument.");
+        static_assert(Detail::staticArgumentsAreComplete(Arguments),
+            "Every argument of a static schema must be created by staticSwitch, staticPositional or staticOption, and options must take at least one value.");
+        static_assert(Detail::staticNamesAreUnique(Arguments),
+            "Every argument of a static schema must have a unique name.");
+        static_assert(Detail::staticIdentifiersAreValid(Arguments),
+            "Identifiers may only contain letters and dashes, and must not end in a dash.");
+        static_assert(Detail::staticIdentifiersAreUnique(Arguments),
+            "Every identifier of a static schema must be unique.");
+
+        public:
+            static constexpr size_t NOT_FOUND = (size_t)-1;
+
+            // The number of arguments in the schema.
+            static constexpr size_t size = std::size(Arguments);
+
+            /**
+             * This method returns the index of an argument by name. It can be
+             * evaluated at compile time.
+             *
+             * @param {std::string_view} name The name of the argument.
+             * @return {size_t} The index of the argument if found. NOT_FOUND otherwise.
+             */
+            static constexpr size_t indexOf(std::string_view name) noexcept;
+
+            /**
+             * This method returns the index of the argument an identifier is
+             * registered to. Prefixing dashes are ignored. It can be evaluated
+             * at compile time.
+             *
+             * @param {std::string_view} identifier The identifier.
+             * @return {size_t} The index of the argument if found. NOT_FOUND otherwise.
+             */
+            static constexpr size_t findIdentifier(std::string_view identifier) noexcept;
+
+            /**
+             * This method parses argv without allocating.
+             *
+             * @param {int} argc The argument count.
+             * @param {char**} argv The argument vector, which must outlive the result.
+             * @return {StaticParseResult} The state of every argument.
+             */
+            static StaticParseResult<Arguments> parse(int argc, char* argv[]) noexcept;
+
+        private:
+            friend class StaticParseResult<Arguments>;
+
+            static constexpr size_t identifier_count_ = Detail::countStaticIdentifiers(Arguments);
+            static constexpr size_t positional_count_ = Detail::countStaticPositionals(Arguments);
+
+            static constexpr StaticIdentifierTable<identifier_count_> table_ = StaticIdentifierTable<identifier_count_>::build(Arguments);
+            static constexpr std::array<size_t, size + 1> offsets_ = Detail::staticValueOffsets(Arguments);
+            static constexpr std::array<size_t, positional_count_> positionals_ = Detail::staticPositionals<positional_count_>(Arguments);
+    };
+
+    /**
+     * This class stores the outcome of parsing a command line with a
+     * StaticParser. It holds views into argv rather than copies, in storage
+     * sized at compile time, and can be kept on the stack.
+     *
+     * Arguments are referred to by index in the array the parser was
+     * generated from, as returned by StaticParser::indexOf, or by name.
+     */
+    template <const auto& Arguments>
+    class StaticParseResult{
+        public:
+            /**
+             * These methods return whether an argument was found in the
+             * command line.
+             * @param {size_t|std::string_view} The index or name of the argument.
+             * @return {bool} Whether the argument is active.
+             */
+            bool isActive(size_t index) const noexcept;
+            bool isActive(std::string_view name) const noexcept;
+
+            /**
+             * These methods return the values of an argument.
+             * @param {size_t|std::string_view} The index or name of the argument.
+             * @return {Span<std::string_view>} The values of the argument. Empty if it was not found.
+             */
+            Span<std::string_view> getValueView(size_t index) const noexcept;
+            Span<std::string_view> getValueView(std::string_view name) const noexcept;
+
+            /**
+             * These methods return a value of an argument. The typed overload
+             * converts numbers with convertNumber, and constructs other types
+             * from the value.
+             * @param {size_t|std::string_view} The index or name of the argument.
+             * @param {size_t} position The position of the value.
+             * @return {std::string_view|Expected<T>} The value, or an empty view or a failure if there is none.
+             */
+            std::string_view getValue(size_t index, size_t position = 0) const noexcept;
+            std::string_view getValue(std::string_view name, size_t position = 0) const noexcept;
+            template <typename T> Expected<T> getValue(size_t index, size_t position = 0) const;
+            template <typename T> Expected<T> getValue(std::string_view name, size_t position = 0) const;
+
+            /**
+             * This method returns the program name parsed from the command
+             * line.
+             * @return {std::string_view} The name of the program.
+             */
+            std::string_view getProgramName() const noexcept;
+
+            /**
+             * These methods describe why parsing stopped, if it did: an option
+             * was given more values than it can hold.
+             * @return {std::string_view|size_t} The reason, empty if parsing succeeded, and the index of the argument at fault.
+             */
+            std::string_view getError() const noexcept;
+            size_t getErrorArgument() const noexcept;
+
+        private:
+            typedef StaticParser<Arguments> Schema;
+            friend class StaticParser<Arguments>;
+
+            std::array<std::string_view, Schema::offsets_[Schema::size]> values_{};
+            std::array<size_t, Schema::size> counts_{};
+            std::array<bool, Schema::size> active_{};
+            std::string_view program_name_;
+            std::string_view error_;
+            size_t error_argument_ = Schema::NOT_FOUND;
+    };
+
+
+    /////////////////////// Template Method Definitions ///////////////////////
+
+    template <size_t Count>
+    template <size_t N>
+    constexpr StaticIdentifierTable<Count> StaticIdentifierTable<Count>::build(const StaticArgument (&arguments)[N]) noexcept{
+        StaticIdentifierTable<Count> table;
+        if constexpr (Count == 0) {
+            return table;
+        }
+        else {
+            // Duplicates are reported by StaticParser, and could never be
+            // placed.
+            if (!Detail::staticIdentifiersAreUnique(arguments)) return table;
+
+            // Strip every identifier of its dashes and hash it.
+            std::array<Entry, Count> sources{};
+            std::array<uint64_t, Count> hashes{};
+            size_t count = 0;
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = 0; j < arguments[i].identifier_count; j++) {
+                    std::string_view key = Detail::stripDashes(arguments[i].identifiers[j]);
+                    sources[count].key = key;
+                    sources[count].argument = i;
+                    hashes[count] = Detail::hashBytes(key.data(), key.size());
+                    count++;
+                }
+            }
+
+            // Group the keys by bucket, and place the largest buckets first as
+            // they are the hardest to fit.
+            std::array<size_t, Count + 1> starts{};
+            for (size_t i = 0; i < Count; i++) starts[Detail::bucketOf(hashes[i], Count) + 1]++;
+            for (size_t i = 0; i < Count; i++) starts[i + 1] += starts[i];
+            std::array<size_t, Count> members{};
+            std::array<size_t, Count> filled{};
+            for (size_t i = 0; i < Count; i++) {
+                size_t bucket = Detail::bucketOf(hashes[i], Count);
+                members[starts[bucket] + filled[bucket]++] = i;
+            }
+            std::array<size_t, Count> order{};
+            for (size_t i = 0; i < Count; i++) {
+                size_t j = i;
+                for (; j > 0 && filled[order[j - 1]] < filled[i]; j--) order[j] = order[j - 1];
+                order[j] = i;
+            }
+
+            std::array<bool, Count> occupied{};
+            std::array<size_t, Count> placement{};
+            size_t position = 0;
+
+            // Find a seed for every bucket with more than one key such that all
+            // its keys hash to free slots.
+            for (; position < Count && filled[order[position]] > 1; position++) {
+                size_t bucket = order[position];
+                int32_t seed = 1;
+                for (;; seed++) {
+                    size_t placed = 0;
+                    for (; placed < filled[bucket]; placed++) {
+                        size_t slot = Detail::slotOf(hashes[members[starts[bucket] + placed]], seed, Count);
+                        bool taken = occupied[slot];
+                        for (size_t i = 0; i < placed; i++) taken = taken || placement[i] == slot;
+                        if (taken) break;
+                        placement[placed] = slot;
+                    }
+                    if (placed == filled[bucket]) break;
+                }
+                table.displacements_[bucket] = seed;
+                for (size_t i = 0; i < filled[bucket]; i++) {
+                    occupied[placement[i]] = true;
+                    table.entries_[placement[i]] = sources[members[starts[bucket] + i]];
+                }
+            }
+
+            // Buckets with a single key point straight to any free slot.
+            size_t free_slot = 0;
+            for (; position < Count && filled[order[position]] == 1; position++) {
+                while (occupied[free_slot]) free_slot++;
+                occupied[free_slot] = true;
+                table.displacements_[order[position]] = -(int32_t)free_slot - 1;
+                table.entries_[free_slot] = sources[members[starts[order[position]]]];
+            }
+            return table;
+        }
+    };
+
+    template <size_t Count>
+    constexpr size_t StaticIdentifierTable<Count>::find(std::string_view identifier) const noexcept{
+        if constexpr (Count == 0) {
+            return NOT_FOUND;
+        }
+        else {
+            std::string_view key = Detail::stripDashes(identifier);
+            uint64_t hash = Detail::hashBytes(key.data(), key.size());
+            int32_t displacement = displacements_[Detail::bucketOf(hash, Count)];
+            size_t slot = displacement < 0?
+                (size_t)(-displacement - 1) : Detail::slotOf(hash, displacement, Count);
+            return entries_[slot].key == key? entries_[slot].argument : NOT_FOUND;
+        }
+    };
+
+    template <const auto& Arguments>
+    constexpr size_t StaticParser<Arguments>::indexOf(std::string_view name) noexcept{
+        for (size_t i = 0; i < size; i++) {
+            if (Arguments[i].name == name) return i;
+        }
+        return NOT_FOUND;
+    };
+
+    template <const auto& Arguments>
+    constexpr size_t StaticParser<Arguments>::findIdentifier(std::string_view identifier) noexcept{
+        return table_.find(identifier);
+    };
+
+    template <const auto& Arguments>
+    StaticParseResult<Arguments> StaticParser<Arguments>::parse(int argc, char* argv[]) noexcept{
+        StaticParseResult<Arguments> result;
+        if (argc > 0) {
+            std::string_view program_name(argv[0]);
+            size_t separator = program_name.find_last_of("/\\");
+            result.program_name_ = separator == std::string_view::npos? program_name : program_name.substr(separator + 1);
+        }
+
+        // The argument values are being read for, if any.
+        size_t current = NOT_FOUND;
+        size_t positional = 0;
+        for (int i = 1; i < argc; i++) {
+            std::string_view argument(argv[i]);
+            if (argument.size() <= 1) continue;
+
+            if (argument[0] == '-') {
+                size_t index = table_.find(argument);
+                if (index == NOT_FOUND) continue;
+                result.active_[index] = true;
+                if (Arguments[index].type != ArgType::Switch) current = index;
+                continue;
+            }
+
+            // If no argument is loaded, this is a positional.
+            if (current == NOT_FOUND && positional < positional_count_) current = positionals_[positional];
+            if (current == NOT_FOUND) continue;
+
+            if (Arguments[current].type == ArgType::Option && result.counts_[current] == Arguments[current].max_values) {
+                result.error_ = "Too many arguments to option.";
+                result.error_argument_ = current;
+                return result;
+            }
+            result.values_[offsets_[current] + result.counts_[current]++] = argument;
+            result.active_[current] = true;
+
+            // Unload positionals after their value, and options once full.
+            if (Arguments[current].type == ArgType::Positional) {
+                positional++;
+                current = NOT_FOUND;
+            }
+            else if (result.counts_[current] == Arguments[current].max_values) {
+                current = NOT_FOUND;
+            }
+        }
+        return result;
+    };
+
+    template <const auto& Arguments>
+    bool StaticParseResult<Arguments>::isActive(size_t index) const noexcept{
+        return index < Schema::size && active_[index];
+    };
+
+    template <const auto& Arguments>
+    bool StaticParseResult<Arguments>::isActive(std::string_view name) const noexcept{
+        return isActive(Schema::indexOf(name));
+    };
+
+    template <const auto& Arguments>
+    Span<std::string_view> StaticParseResult<Arguments>::getValueView(size_t index) const noexcept{
+        if (index >= Schema::size) return Span<std::string_view>();
+        return Span<std::string_view>(values_.data() + Schema::offsets_[index], counts_[index]);
+    };
+
+    template <const auto& Arguments>
+    Span<std::string_view> StaticParseResult<Arguments>::getValueView(std::string_view name) const noexcept{
+        return getValueView(Schema::indexOf(name));
+    };
+
+    template <const auto& Arguments>
+    std::string_view StaticParseResult<Arguments>::getValue(size_t index, size_t position) const noexcept{
+        Span<std::string_view> values = getValueView(index);
+        return position < values.size()? values[position] : std::string_view();
+    };
+
+    template <const auto& Arguments>
+    std::string_view StaticParseResult<Arguments>::getValue(std::string_view name, size_t position) const noexcept{
+        return getValue(Schema::indexOf(name), position);
+    };
+
+    template <const auto& Arguments>
+    template <typename T>
+    Expected<T> StaticParseResult<Arguments>::getValue(size_t index, size_t position) const{
+        Span<std::string_view> values = getValueView(index);
+        if (position >= values.size()) return Failure("No value given.");
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) return convertNumber<T>(values[position]);
+        else return T(values[position]);
+    };
+
+    template <const auto& Arguments>
+    template <typename T>
+    Expected<T> StaticParseResult<Arguments>::getValue(std::string_view name, size_t position) const{
+        return getValue<T>(Schema::indexOf(name), position);
+    };
+
+    template <const auto& Arguments>
+    std::string_view StaticParseResult<Arguments>::getProgramName() const noexcept{
+        return program_name_;
+    };
+
+    template <const auto& Arguments>
+    std::string_view StaticParseResult<Arguments>::getError() const noexcept{
+        return error_;
+    };
+
+    template <const auto& Arguments>
+    size_t StaticParseResult<Arguments>::getErrorArgument() const noexcept{
+        return error_argument_;
+    };
+}
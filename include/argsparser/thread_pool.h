@@ -0,0 +1,94 @@
+/**
+ * thread_pool.h
+ * 
+ * This file contains the declaration of the ThreadPool class, a work-stealing
+ * pool used to run independent tasks of the library in parallel.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ArgsParser
+{
+    /**
+     * This class runs a number of independent tasks over a fixed set of
+     * threads. The calling thread takes part in the work, so a pool of N
+     * threads starts N-1 workers.
+     * 
+     * The tasks of a run are split evenly between the threads up front. A
+     * thread that runs out of tasks steals half of the remaining tasks of
+     * another, so threads stay busy even when tasks take uneven time, without
+     * any shared queue being contended in the common case.
+     */
+    class ThreadPool{
+        public:
+            /**
+             * Constructor of the thread pool.
+             * 
+             * @param {size_t} threads The number of threads to run tasks on, including the caller. Defaults to the number of hardware threads.
+             */
+            explicit ThreadPool(size_t threads = 0);
+            ThreadPool(const ThreadPool& other) = delete;
+            ThreadPool& operator=(const ThreadPool& other) = delete;
+            ~ThreadPool();
+
+            /**
+             * This method returns the number of threads tasks are run on,
+             * including the caller.
+             * 
+             * @return {size_t} The number of threads of the pool.
+             */
+            size_t size() const noexcept;
+
+            /**
+             * This method calls a task once for every index in [0, count) and
+             * returns once all calls have completed. Calls may run in any
+             * order and on any thread of the pool. Runs are serialized, so
+             * the pool may be shared. A run started from a task of the same
+             * pool calls its tasks in order on the thread starting it.
+             * 
+             * @param {size_t} count The number of tasks to run.
+             * @param {function<void(size_t)>} task The task to call with each index.
+             * @except {std::exception} The first exception thrown by a task, after every task has completed.
+             */
+            void run(size_t count, const std::function<void(size_t)>& task);
+
+        private:
+            // The range of task indices owned by a thread.
+            struct Queue{
+                std::mutex mutex;
+                size_t begin = 0;
+                size_t end = 0;
+            };
+
+            std::vector<std::thread> workers_;
+            std::unique_ptr<Queue[]> queues_;
+            size_t size_;
+
+            // Serializes calls to run.
+            std::mutex run_mutex_;
+
+            // Guards the fields below, which describe the current run.
+            std::mutex mutex_;
+            std::condition_variable wake_;
+            std::condition_variable done_;
+            const std::function<void(size_t)>* task_;
+            size_t generation_;
+            size_t active_;
+            bool stopping_;
+            std::exception_ptr error_;
+
+            void workerLoop(size_t self);
+            void work(size_t self);
+            bool next(size_t self, size_t& index);
+    };
+}
@@ -34,4 +34,29 @@ namespace ArgsParser
     };
 
     const Token NULL_TOKEN = {ArgType::Null, 0};
+
+    /**
+     * This struct is the type of the tokens returned by the registration
+     * methods of typed arguments. It carries the type of the argument, so the
+     * value can be retrieved without checking the type of its state at run
+     * time:
+     *      ArgsParser::TypedToken<int> port = myParser.registerOption<int>("port", {"port"});
+     *      int value = myParser.getValue(port);
+     * 
+     * It is a Token, and can be used wherever one is expected. It must only be
+     * used with the parser it was returned by, or with the schemas and results
+     * derived from it. Only the parser can create a typed token from a token,
+     * so that it always refers to an argument of its type.
+     */
+    template <typename T>
+    struct TypedToken : public Token
+    {
+        TypedToken() noexcept : Token(NULL_TOKEN) {};
+
+        private:
+            explicit TypedToken(const Token& token) noexcept : Token(token) {};
+
+            friend class Parser;
+            friend class ParseResult;
+    };
 }
\ No newline at end of file
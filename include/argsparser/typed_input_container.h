@@ -9,30 +9,108 @@
  */
 
 #pragma once
+#include <atomic>
+#include <mutex>
+#include <argsparser/converters.h>
 #include <argsparser/input_container.h>
+#include <argsparser/span.h>
 #include <argsparser/typed_value_wrapper.h>
 
 namespace ArgsParser
 {
+    template <typename T> class TypedInputContainer;
+
+    /**
+     * This struct stores the parse state of a TypedInputContainer. In addition
+     * to the raw user input it holds the result of converting each input to
+     * the type of the container.
+     * 
+     * If the container is lazy, the input is converted the first time the
+     * value or validation of the state is read instead of while parsing.
+     */
+    template <typename T>
+    struct TypedInputState : public InputState
+    {
+        // The user input converted to type T. If the container is lazy, the
+        // values are allocated from the default heap, as they are converted
+        // on whichever thread first reads them.
+        std::pmr::vector<T> converted_value;
+
+        // The container whose conversion is pending, or nullptr once it has
+        // run or if the container is not lazy.
+        const TypedInputContainer<T>* pending;
+
+        // Guard the deferred conversion and callback so that they run once,
+        // even when the state is read from several threads at once. The
+        // mutex is recursive so that the callbacks may read the state, and
+        // converting is only touched under it.
+        mutable std::recursive_mutex conversion_mutex;
+        mutable std::atomic<bool> converted;
+        mutable bool converting;
+
+        // The values converted from each part of the input while it is
+        // post-processed in parallel. They are allocated from the default
+        // heap, as the resource of the state may not be safe to share between
+        // threads.
+        std::vector<std::pmr::vector<T>> part_values;
+
+        explicit TypedInputState(std::pmr::memory_resource* resource = nullptr);
+        TypedInputState(bool lazy, std::pmr::memory_resource* resource);
+        TypedInputState(const TypedInputState<T>& other, std::pmr::memory_resource* resource);
+
+        /**
+         * This method gets the converted value of the user input.
+         * 
+         * @return {TypedValueWrapper<T>} The wrapped state and converted input stored in this state.
+         */
+        TypedValueWrapper<T> getConvertedValue() const;
+
+        /**
+         * This method gets the converted value of the user input as a view
+         * into this state, without copying it.
+         * 
+         * @return {Span<T>} The converted input stored in this state.
+         */
+        Span<T> getConvertedView() const;
+
+        /**
+         * This method runs the conversion and validation of the user input if
+         * they were deferred, followed by the callback or error callback of
+         * the container. Callbacks run on the thread that first reads the
+         * value, and may read the value themselves. Other threads reading the
+         * value wait until the callbacks return. An exception thrown by
+         * the conversion or the callback rejects the input, and is passed to
+         * the error callback instead of being thrown.
+         */
+        virtual void forceConversion() const;
+
+        /**
+         * Cloning method. The clone is allocated from the same memory resource
+         * as this object.
+         * 
+         * @return {ContainerState*} A pointer to a new TypedInputState object cloned from this object.
+         */
+        virtual TypedInputState<T>* clone() const;
+
+        /**
+         * This method destroys this state and returns its memory to the
+         * resource it was allocated from.
+         */
+        virtual void destroy() noexcept;
+    };
 
     /**
      * This class is a InputContainer with an assigned type. It is to be
      * used when a specific return type is desired from an option, if said
      * type is known.
-     * A converter function must be provided that transforms a string into the
-     * desired type.
+     * A converter function transforms each string into the desired type. If
+     * none is provided, the default converter for the type is used (see
+     * defaultConverter).
      * This class is used by positionals and input parameters.
      */
     template <typename T>
     class TypedInputContainer : public InputContainer {
         public:    
-            /**
-             * This method gets the converted value of the user input.
-             * 
-             * @return {T} The result of the conversion of the user input stored in this parser.
-             */
-            TypedValueWrapper<T> getConvertedValue() const;
-
             /**
              * This is the constructor for the typed user input container.
              * 
@@ -43,9 +121,10 @@ namespace ArgsParser
              * @param {string} placeholder_text The placeholder text of the argument stored in this container.
              * @param {size_t} max_values The maximum number of inputs this container can hold.
              * @param {Validator} validator A function to use for input validation.
-             * @param {Converter<T>} converter A function to use for input conversion.
+             * @param {Converter<T>} converter A function to use for input conversion. Defaults to defaultConverter<T>().
              * @param {ErrorHandler} error_callback A function to call if validation fails.
              * @param {Callback} callback A function to call if validation succeeds.
+             * @param {memory_resource*} resource The memory resource to allocate the strings of the container from.
              */
             TypedInputContainer(
                 const ArgType type,
@@ -57,15 +136,41 @@ namespace ArgsParser
                 const Converter<T>& converter = nullptr,
                 const Validator<T>& validator = nullptr,
                 const ErrorHandler& error_callback = nullptr,
-                const Callback& callback = nullptr
+                const Callback& callback = nullptr,
+                std::pmr::memory_resource* resource = nullptr
             );
 
+            /**
+             * This is the copy constructor for the typed user input container.
+             * The strings of the container are copied into the memory resource
+             * provided.
+             * 
+             * @param {TypedInputContainer<T>} other The container to copy.
+             * @param {memory_resource*} resource The memory resource to allocate the strings of the container from.
+             */
+            TypedInputContainer(const TypedInputContainer<T>& other, std::pmr::memory_resource* resource);
+
             /**
              * Cloning method.
              * 
+             * @param {memory_resource*} resource The resource to allocate the clone from. Defaults to the resource of this object.
              * @return {Container*} A pointer to a new TypedInputContainer object cloned from this object.
              */
-            virtual TypedInputContainer<T>* clone() const;
+            virtual TypedInputContainer<T>* clone(std::pmr::memory_resource* resource = nullptr) const;
+
+            /**
+             * This method destroys this container and returns its memory to the
+             * resource it was allocated from.
+             */
+            virtual void destroy() noexcept;
+
+            /**
+             * This method creates an empty parse state for this container.
+             * 
+             * @param {memory_resource*} resource The resource to allocate the state and its values from.
+             * @return {ContainerState*} A pointer to a new TypedInputState object.
+             */
+            virtual TypedInputState<T>* createState(std::pmr::memory_resource* resource = nullptr) const;
 
             /**
              * This is the destructor for the typed user input container.
@@ -73,13 +178,12 @@ namespace ArgsParser
             virtual ~TypedInputContainer() {};
 
         private:
-            std::vector<T> converted_value_;
-
             const Converter<T> converter_;
 
             const Validator<T> validator_;     
 
-            friend class Parser;
+            friend struct SchemaImpl;
+            friend struct TypedInputState<T>;
 
             /**
              * This method executes all post-processing logic associated with 
@@ -91,18 +195,179 @@ namespace ArgsParser
              * a single validation or conversion fails the error callback will 
              * be called instead.
              * 
+             * If the container is lazy, this is deferred until the value is
+             * first read.
+             * 
              * It is virtual, as the derived classes use different post-processing
              * logic to account for other features.
+             * 
+             * @param {ContainerState} state The parse state created by this container.
              */
-            virtual void postProcess();
+            virtual void postProcess(ContainerState& state) const;
+
+            /**
+             * This method converts and validates each input of a state,
+             * storing the converted values and the result of validation.
+             * 
+             * @param {TypedInputState<T>} state The parse state created by this container.
+             */
+            void convert(TypedInputState<T>& state) const;
+
+            /**
+             * These methods convert and validate the input in parts that may
+             * be processed in parallel. See Container::prepare. If the
+             * container is lazy, the input is not split and the conversion is
+             * deferred as in postProcess.
+             * 
+             * @param {ContainerState} state The parse state created by this container.
+             * @param {size_t} part_size The largest number of inputs in a part.
+             * @param {size_t} part The index of the part to process.
+             * @return {size_t} The number of parts the input was split into.
+             */
+            virtual size_t prepare(ContainerState& state, size_t part_size) const;
+            virtual void process(ContainerState& state, size_t part) const;
+            virtual void complete(ContainerState& state) const;
+            virtual bool hasAsyncValidator() const noexcept;
+
+            /**
+             * This method converts and validates a range of the inputs of a
+             * state, appending their values to a vector and stopping at the
+             * first one rejected, whose values are not kept.
+             * 
+             * If a list of pending validations is given and the validator is
+             * asynchronous, the validations of the values kept are started
+             * once the range is converted, and added to the list instead of
+             * being awaited.
+             * 
+             * @param {TypedInputState<T>} state The parse state created by this container.
+             * @param {size_t} first The index of the first input to convert.
+             * @param {size_t} last The index past the last input to convert.
+             * @param {pmr::vector<T>} values The vector to append the converted values to.
+             * @param {string} reason Set to the reason the input was rejected, if one was.
+             * @param {vector<InputState::PendingValidation>*} pending The list to add asynchronous validations to, if any.
+             * @return {size_t} The index of the input rejected, or last if none was.
+             */
+            size_t convert(const TypedInputState<T>& state, size_t first, size_t last, std::pmr::vector<T>& values, std::string& reason,
+                           std::vector<InputState::PendingValidation>* pending = nullptr) const;
+
+            /**
+             * This method calls the callback if every input of a converted
+             * state is valid, and the error callback otherwise.
+             * 
+             * @param {TypedInputState<T>} state The parse state created by this container.
+             */
+            void notify(const TypedInputState<T>& state) const;
     };
 
 
     /////////////////////// Template Method Definitions ///////////////////////
 
     template <typename T>
-    TypedValueWrapper<T> TypedInputContainer<T>::getConvertedValue() const {
-        return TypedValueWrapper<T>(active_, converted_value_);
+    TypedInputState<T>::TypedInputState(std::pmr::memory_resource* resource) :
+        InputState(resource),
+        converted_value(this->resource),
+        pending(nullptr),
+        converted(false),
+        converting(false)
+        {};
+
+    template <typename T>
+    TypedInputState<T>::TypedInputState(bool lazy, std::pmr::memory_resource* resource) :
+        InputState(resource),
+        converted_value(lazy? std::pmr::new_delete_resource() : this->resource),
+        pending(nullptr),
+        converted(false),
+        converting(false)
+        {};
+
+    template <typename T>
+    TypedInputState<T>::TypedInputState(const TypedInputState<T>& other, std::pmr::memory_resource* resource) :
+        InputState(other, resource),
+        converted_value(other.converted_value, this->resource),
+        pending(nullptr),
+        converted(true),
+        converting(false)
+        {};
+
+    template <typename T>
+    TypedValueWrapper<T> TypedInputState<T>::getConvertedValue() const {
+        forceConversion();
+        return TypedValueWrapper<T>(active, std::vector<T>(converted_value.begin(), converted_value.end()));
+    };
+
+    template <typename T>
+    Span<T> TypedInputState<T>::getConvertedView() const {
+        forceConversion();
+        return Span<T>(converted_value.data(), converted_value.size());
+    };
+
+    template <typename T>
+    void TypedInputState<T>::forceConversion() const {
+        if (pending == nullptr || converted.load(std::memory_order_acquire)) return;
+
+        // The conversion and the callback write to the state before it is
+        // published, so every reader that returns sees the whole of it, and
+        // the state remains safe to read concurrently. A callback reading
+        // the state on the same thread gets its converted value.
+        std::lock_guard<std::recursive_mutex> lock(conversion_mutex);
+        if (converted.load(std::memory_order_relaxed) || converting) return;
+        converting = true;
+
+        // The state is read through accessors that do not throw, so failures
+        // are recorded in the state instead, as a rejected input would be.
+        TypedInputState<T>& self = const_cast<TypedInputState<T>&>(*this);
+        try {
+            pending->convert(self);
+        }
+        catch (const std::exception& e) {
+            self.converted_value.clear();
+            self.validation = false;
+            self.validation_failure_reason = e.what();
+        }
+        catch (...) {
+            self.converted_value.clear();
+            self.validation = false;
+            self.validation_failure_reason = "Unknown error during conversion.";
+        }
+
+        // A callback that throws is reported to the error callback, but an
+        // error callback that throws is not called again.
+        const bool valid = validation;
+        try {
+            pending->notify(*this);
+        }
+        catch (const std::exception& e) {
+            if (valid) {
+                self.validation = false;
+                self.validation_failure_reason = e.what();
+            }
+        }
+        catch (...) {
+            if (valid) {
+                self.validation = false;
+                self.validation_failure_reason = "Unknown error in callback.";
+            }
+        }
+        if (valid && !validation && pending->error_callback_ != nullptr) {
+            try {
+                pending->error_callback_(std::runtime_error(validation_failure_reason));
+            }
+            catch (...) {
+            }
+        }
+        converted.store(true, std::memory_order_release);
+    };
+
+    template <typename T>
+    TypedInputState<T>* TypedInputState<T>::clone() const {
+        // Copies never defer conversion, so run it before copying.
+        forceConversion();
+        return create<TypedInputState<T>>(resource, *this);
+    };
+
+    template <typename T>
+    void TypedInputState<T>::destroy() noexcept {
+        dispose(this, resource);
     };
 
     template <typename T>
@@ -116,7 +381,8 @@ namespace ArgsParser
         const Converter<T>& converter,
         const Validator<T>& validator,
         const ErrorHandler& error_callback,
-        const Callback& callback
+        const Callback& callback,
+        std::pmr::memory_resource* resource
     ) : InputContainer(
             type,
             name, 
@@ -126,56 +392,162 @@ namespace ArgsParser
             max_values,
             nullptr,
             error_callback,
-            callback
+            callback,
+            resource
             ),
-        converter_(converter),
+        converter_(converter != nullptr? converter : defaultConverter<T>()),
         validator_(validator)
         {};
 
     template <typename T>
-    TypedInputContainer<T>* TypedInputContainer<T>::clone() const
+    TypedInputContainer<T>::TypedInputContainer(const TypedInputContainer<T>& other, std::pmr::memory_resource* resource) :
+        InputContainer(other, resource),
+        converter_(other.converter_),
+        validator_(other.validator_)
+        {};
+
+    template <typename T>
+    TypedInputContainer<T>* TypedInputContainer<T>::clone(std::pmr::memory_resource* resource) const
+    {
+        return create<TypedInputContainer<T>>(resource != nullptr? resource : getMemoryResource(), *this);
+    };
+
+    template <typename T>
+    void TypedInputContainer<T>::destroy() noexcept
+    {
+        dispose(this, getMemoryResource());
+    };
+
+    template <typename T>
+    TypedInputState<T>* TypedInputContainer<T>::createState(std::pmr::memory_resource* resource) const
     {
-        TypedInputContainer<T>* copy = new TypedInputContainer<T>(
-            type_,
-            name_,
-            identifiers_,
-            description_,
-            placeholder_text_,
-            max_values_,
-            converter_,
-            validator_,
-            error_callback_,
-            callback_
-        );
-        copy->user_input_ = user_input_;
-        copy->validation_ = validation_;
-        copy->validation_failure_reason_ = validation_failure_reason_;
-        copy->converted_value_ = converted_value_;
-        return copy;
-    };
-
-    template <typename T>
-    void TypedInputContainer<T>::postProcess() {
-        if (converter_ != nullptr) {
-            for (size_t i = 0; i < user_input_.size(); i++) {
-                try {
-                    T input = converter_(user_input_[i]);
-                    if (validator_ != nullptr) {
-                        bool valid = validator_(input);
-                        if (!valid) throw std::runtime_error("Unspecified validation error.");
-                    }
-
-                    converted_value_.push_back(input);
-                }
-                catch (std::exception& e) {
-                    validation_ = false;
-                    validation_failure_reason_ = e.what();
-
-                    if(error_callback_ != nullptr) error_callback_(e);
-                    return;
-                }
+        return create<TypedInputState<T>>(resource, lazy_);
+    };
+
+    template <typename T>
+    void TypedInputContainer<T>::postProcess(ContainerState& container_state) const {
+        TypedInputState<T>& state = static_cast<TypedInputState<T>&>(container_state);
+        if (lazy_) {
+            state.pending = this;
+            return;
+        }
+        convert(state);
+        notify(state);
+    };
+
+    template <typename T>
+    void TypedInputContainer<T>::convert(TypedInputState<T>& state) const {
+        std::string reason;
+        const size_t size = state.user_input.size();
+        state.validation = convert(state, 0, size, state.converted_value, reason) == size;
+        state.validation_failure_reason = state.validation? "" : std::move(reason);
+    };
+
+    template <typename T>
+    size_t TypedInputContainer<T>::convert(const TypedInputState<T>& state, size_t first, size_t last, std::pmr::vector<T>& values, std::string& reason,
+                                           std::vector<InputState::PendingValidation>* pending) const {
+        if (converter_ == nullptr) return last;
+
+        // Asynchronous validations refer to their values, so they are only
+        // started once appending values can no longer move them.
+        const bool deferred = pending != nullptr && validator_.isAsync();
+        std::vector<std::pair<size_t, size_t>> first_values;
+        size_t rejected = last;
+        for (size_t i = first; i < last; i++) {
+            // Values are appended in place, as an input may hold several.
+            size_t first_value = values.size();
+            Status status = ARGSPARSER_TIME_ARGUMENT(converter_ns, converter_(state.user_input[i], values));
+            for (size_t j = first_value; status && validator_ != nullptr && !deferred && j < values.size(); j++) {
+                status = ARGSPARSER_TIME_ARGUMENT(validator_ns, validator_(values[j]));
+            }
+            if (!status) {
+                // Values of a rejected input are not kept.
+                values.erase(values.begin() + first_value, values.end());
+                reason = status.error();
+                rejected = i;
+                break;
             }
+            if (deferred) first_values.emplace_back(i, first_value);
+        }
+
+        if (deferred) {
+            pending->reserve(pending->size() + values.size());
+            for (size_t i = 0; i < first_values.size(); i++) {
+                size_t end = i + 1 < first_values.size()? first_values[i + 1].second : values.size();
+                for (size_t j = first_values[i].second; j < end; j++)
+                    pending->push_back(InputState::PendingValidation{first_values[i].first, j, validator_.start(values[j])});
+            }
+        }
+        return rejected;
+    };
+
+    template <typename T>
+    size_t TypedInputContainer<T>::prepare(ContainerState& container_state, size_t part_size) const {
+        TypedInputState<T>& state = static_cast<TypedInputState<T>&>(container_state);
+        if (lazy_) {
+            state.pending = this;
+            return 0;
+        }
+        const size_t parts = InputContainer::prepare(state, part_size);
+        state.part_values.clear();
+        state.part_values.reserve(parts);
+        for (size_t i = 0; i < parts; i++) state.part_values.emplace_back(std::pmr::new_delete_resource());
+        return parts;
+    };
+
+    template <typename T>
+    void TypedInputContainer<T>::process(ContainerState& container_state, size_t part) const {
+        TypedInputState<T>& state = static_cast<TypedInputState<T>&>(container_state);
+        const size_t first = part * state.part_size;
+        const size_t last = std::min(first + state.part_size, state.user_input.size());
+        state.parts[part].rejected = convert(state, first, last, state.part_values[part], state.parts[part].reason, &state.parts[part].pending);
+    };
+
+    template <typename T>
+    void TypedInputContainer<T>::complete(ContainerState& container_state) const {
+        TypedInputState<T>& state = static_cast<TypedInputState<T>&>(container_state);
+        if (state.pending != nullptr) return;
+
+        // Values are gathered in the order of the input, up to the first part
+        // with a rejected input, as a sequential parse would keep them. Every
+        // validation is awaited first, as they refer to the values.
+        for (size_t i = 0; i < state.parts.size(); i++) {
+            size_t rejected_value = InputContainer::await(state.parts[i]);
+            if (rejected_value != std::string::npos)
+                state.part_values[i].erase(state.part_values[i].begin() + rejected_value, state.part_values[i].end());
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < state.part_values.size(); i++) count += state.part_values[i].size();
+        state.converted_value.reserve(state.converted_value.size() + count);
+        state.validation = true;
+        state.validation_failure_reason = "";
+        for (size_t i = 0; i < state.parts.size(); i++) {
+            std::pmr::vector<T>& values = state.part_values[i];
+            state.converted_value.insert(state.converted_value.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+            if (state.parts[i].rejected < std::min((i + 1) * state.part_size, state.user_input.size())) {
+                state.validation = false;
+                state.validation_failure_reason = std::move(state.parts[i].reason);
+                break;
+            }
+        }
+        state.parts.clear();
+        state.part_values.clear();
+        notify(state);
+    };
+
+    template <typename T>
+    bool TypedInputContainer<T>::hasAsyncValidator() const noexcept {
+        return validator_.isAsync();
+    };
+
+    template <typename T>
+    void TypedInputContainer<T>::notify(const TypedInputState<T>& state) const {
+        if (!state.validation) {
+            // The error is passed to the handler without being thrown.
+            if (error_callback_ != nullptr)
+                ARGSPARSER_TIME_ARGUMENT(callback_ns, error_callback_(std::runtime_error(state.validation_failure_reason)));
+            return;
         }
-        if (callback_ != nullptr) callback_();
+        if (callback_ != nullptr) ARGSPARSER_TIME_ARGUMENT(callback_ns, callback_());
     };
 }
\ No newline at end of file
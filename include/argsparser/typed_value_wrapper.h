@@ -9,6 +9,7 @@
  */
 
 #pragma once
+#include <utility>
 #include <argsparser/common.h>
 
 namespace ArgsParser
@@ -16,14 +17,16 @@ namespace ArgsParser
     template <typename T>
     struct TypedValueWrapper
     {
-        const std::vector<T> typed_input_;
-        const bool active_;
+        std::vector<T> typed_input_;
+        bool active_;
 
         operator bool() const noexcept;
 
         operator T() const noexcept;
 
-        operator std::vector<T>() const noexcept;
+        // The values are moved out of a temporary wrapper instead of copied.
+        operator std::vector<T>() const & noexcept;
+        operator std::vector<T>() && noexcept;
 
         T operator[](size_t position) const noexcept;
 
@@ -48,9 +51,14 @@ namespace ArgsParser
     };
 
     template <typename T>
-    TypedValueWrapper<T>::operator std::vector<T>() const noexcept {
+    TypedValueWrapper<T>::operator std::vector<T>() const & noexcept {
         return typed_input_;
     };
+
+    template <typename T>
+    TypedValueWrapper<T>::operator std::vector<T>() && noexcept {
+        return std::move(typed_input_);
+    };
     
     template <typename T>
     T TypedValueWrapper<T>::operator[](size_t position) const noexcept {
@@ -71,11 +79,11 @@ namespace ArgsParser
 
     template <typename T>
     TypedValueWrapper<T>::TypedValueWrapper():
-        active_(false),
-        typed_input_(std::vector<T>()) {};
+        typed_input_(),
+        active_(false) {};
 
     template <typename T>
     TypedValueWrapper<T>::TypedValueWrapper( bool active, std::vector<T> typed_input):
-        active_(active),
-        typed_input_(typed_input) {};
+        typed_input_(std::move(typed_input)),
+        active_(active) {};
 }
\ No newline at end of file
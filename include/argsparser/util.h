@@ -41,6 +41,17 @@ namespace ArgsTools
      */
     std::string make_identifier(const std::string& string);
 
+    /**
+     * This method makes a valid identifier from a string, like
+     * make_identifier, but reports invalid characters through its return
+     * value instead of throwing an exception.
+     * 
+     * @param {std::string} string The string to make a valid identifier from.
+     * @param {std::string} identifier The string to store the identifier in.
+     * @return {std::string} The reason the string is invalid, or an empty string if it is valid.
+     */
+    std::string try_make_identifier(const std::string& string, std::string& identifier);
+
     /**
      * This method is an error handler that simply prints the e.what() of an
      * exception object.
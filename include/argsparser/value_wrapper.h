@@ -15,8 +15,8 @@ namespace ArgsParser
 {
     struct ValueWrapper
     {
-        const std::vector<std::string> user_input;
-        const bool active;
+        std::vector<std::string> user_input;
+        bool active;
 
         // Implicit conversion to bool.
         operator bool() const noexcept;
@@ -24,8 +24,10 @@ namespace ArgsParser
         // Implicit conversion to string.
         operator std::string() const noexcept;
         
-        // Implicit conversion to vector of strings.
-        operator std::vector<std::string>() const noexcept;
+        // Implicit conversion to vector of strings. The strings are moved out
+        // of a temporary wrapper instead of copied.
+        operator std::vector<std::string>() const & noexcept;
+        operator std::vector<std::string>() && noexcept;
 
         // Accessor operator.
         std::string operator[](size_t position) const noexcept;
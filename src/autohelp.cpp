@@ -7,94 +7,190 @@
  * Copyright (C) 2018 Renan Basilio. All rights reserved.
  */
 
+#include <cerrno>
+#include <cstdlib>
 #include <argsparser/autohelp.h>
+#include <argsparser/parserImpl.h>
 
-namespace ArgsParser
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+#endif
+
+namespace
 {
+    // The width used when that of the terminal cannot be determined.
+    const size_t DEFAULT_WIDTH = 80;
+
+    // The narrowest column descriptions are wrapped to, however wide the
+    // identifiers before them are.
+    const size_t MIN_DESCRIPTION_WIDTH = 20;
+
+    // Returns the number of columns of the terminal a file descriptor refers
+    // to, as given by the COLUMNS variable or by the terminal itself.
+    size_t terminal_width(int fd){
+        const char* columns = std::getenv("COLUMNS");
+        if (columns != nullptr) {
+            long value = std::strtol(columns, nullptr, 10);
+            if (value > 0) return (size_t)value;
+        }
+    #ifndef _WIN32
+        struct winsize size;
+        if (isatty(fd) && ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_col > 0) return size.ws_col;
+    #endif
+        return DEFAULT_WIDTH;
+    }
 
-    void autohelper(Parser *const parser, std::ostream& stream){
+    // Appends text to a buffer, breaking it at spaces so that no line is
+    // longer than width. Lines after the first are indented by indent.
+    void append_wrapped(std::string& buffer, const std::string& text, size_t indent, size_t width){
+        size_t line_length = 0;
+        size_t position = 0;
+        while (position < text.size()) {
+            size_t word_end = text.find(' ', position);
+            if (word_end == std::string::npos) word_end = text.size();
+            size_t word_length = word_end - position;
 
-        std::vector<Token> tokens = parser->getRegisteredTokens();
-        std::vector<std::string> positional_strings;
+            if (line_length > 0 && line_length + 1 + word_length > width) {
+                buffer += '\n';
+                buffer.append(indent, ' ');
+                line_length = 0;
+            }
+            else if (line_length > 0) {
+                buffer += ' ';
+                line_length++;
+            }
+            buffer.append(text, position, word_length);
+            line_length += word_length;
+            position = word_end + 1;
+        }
+        buffer += '\n';
+    }
+}
+
+namespace ArgsParser
+{
+    std::shared_ptr<const std::string> SchemaImpl::getHelpText(std::string_view program_name, size_t width) const{
+        std::lock_guard<std::mutex> lock(help_mutex);
+        if (help_text && help_width == width && help_program_name == program_name) return help_text;
+
+        // Registries hold arguments in the order they were registered, and
+        // every positional and option is held by an InputContainer.
         std::vector<std::pair<std::string, std::string>> switch_strings;
         std::vector<std::pair<std::string, std::string>> option_strings;
+        switch_strings.reserve(registered_switches.size());
+        option_strings.reserve(registered_options.size());
         size_t max_id_size = 0;
 
-        for(Token var : tokens)
-        {
-            const Container* container = parser->getContainer(var);
-
-            if(container->getType() == ArgType::Positional)
-            {
-                positional_strings.push_back(dynamic_cast<const InputContainer*>(container)->getPlaceholderText());
-            }
-            else
-            {
-                std::string id_string = "";
-                std::vector<std::string> identifiers = container->getIdentifiers();
-                for(size_t i = 0; i < identifiers.size(); i++){
-                    id_string += identifiers[i];
-                    if( i != identifiers.size() - 1) id_string += ", ";
-                }
-                if(container->getType() == ArgType::Switch) 
-                    switch_strings.push_back(std::pair<std::string, std::string>(id_string, container->getDescription()));
-                else{
-                    const InputContainer* temp = dynamic_cast<const InputContainer*>(container);
-
-                    std::string placeholder_string = "<" + temp->getPlaceholderText() + ">";
-                    if (temp->getMaxInputs() > 1) placeholder_string = " [" + placeholder_string + "...] ";
-                    else placeholder_string = " " + placeholder_string + " ";
-
-                    id_string += placeholder_string;
-
-                    option_strings.push_back(std::pair<std::string, std::string>(id_string, container->getDescription()));
-                }
-                max_id_size = std::max(max_id_size, id_string.length()+4);
+        auto join_identifiers = [](const Container* container){
+            std::string id_string;
+            for (size_t i = 0; i < container->identifiers_.size(); i++) {
+                if (i != 0) id_string += ", ";
+                id_string += container->identifiers_[i];
             }
+            return id_string;
+        };
+
+        for (size_t i = 0; i < registered_switches.size(); i++) {
+            switch_strings.emplace_back(join_identifiers(registered_switches[i]), registered_switches[i]->getDescription());
+            max_id_size = std::max(max_id_size, switch_strings.back().first.length() + 4);
         }
-        
-        stream << "usage: " << parser->getProgramName() << " ";
-        for(size_t i = 0; i < positional_strings.size(); i++)
-        {
-            stream << "[" << positional_strings[i] << "] ";
+        for (size_t i = 0; i < registered_options.size(); i++) {
+            const InputContainer* container = static_cast<const InputContainer*>(registered_options[i]);
+            std::string id_string = join_identifiers(container);
+            if (container->getMaxInputs() > 1) id_string += " [<" + container->getPlaceholderText() + ">...] ";
+            else id_string += " <" + container->getPlaceholderText() + "> ";
+            option_strings.emplace_back(std::move(id_string), container->getDescription());
+            max_id_size = std::max(max_id_size, option_strings.back().first.length() + 4);
         }
-        stream << "[options]" << std::endl;
-        for(size_t i = 0; i < switch_strings.size(); i++)
-        {
-            stream << "    "
-                   << switch_strings[i].first 
-                   << std::string(max_id_size - switch_strings[i].first.size(), ' ')
-                   << switch_strings[i].second
-                   << std::endl;
+
+        const size_t column = 4 + max_id_size;
+        const size_t description_width = width > column + MIN_DESCRIPTION_WIDTH? width - column : MIN_DESCRIPTION_WIDTH;
+
+        std::shared_ptr<std::string> text = std::make_shared<std::string>();
+        std::string& buffer = *text;
+        buffer += "usage: ";
+        buffer += program_name;
+        buffer += ' ';
+        for (size_t i = 0; i < registered_positionals.size(); i++) {
+            buffer += '[';
+            buffer += static_cast<const InputContainer*>(registered_positionals[i])->getPlaceholderText();
+            buffer += "] ";
         }
-        stream << std::endl << "options:" <<std::endl;
-        for(size_t i = 0; i < option_strings.size(); i++)
-        {
-            stream << "    "
-                   << option_strings[i].first
-                   << std::string(max_id_size - option_strings[i].first.size(), ' ')
-                   << option_strings[i].second
-                   << std::endl;
+        buffer += "[options]\n";
+        for (size_t i = 0; i < switch_strings.size(); i++) {
+            buffer += "    ";
+            buffer += switch_strings[i].first;
+            buffer.append(max_id_size - switch_strings[i].first.size(), ' ');
+            append_wrapped(buffer, switch_strings[i].second, column, description_width);
+        }
+        buffer += "\noptions:\n";
+        for (size_t i = 0; i < option_strings.size(); i++) {
+            buffer += "    ";
+            buffer += option_strings[i].first;
+            buffer.append(max_id_size - option_strings[i].first.size(), ' ');
+            append_wrapped(buffer, option_strings[i].second, column, description_width);
         }
-        exit(0);
+
+        help_text = text;
+        help_width = width;
+        help_program_name = std::string(program_name);
+        return help_text;
     };
 
-    bool Parser::enableAutohelp(){
-        try{
-            // First test if both switches and the name are available.
-            // As there is a distinct possibility of this method being the first
-            // to register anything, we can speed up this test by checking if
-            // nothing has been registered yet.
-            if ( !isNameRegistered("help") && !isIdentifierRegistered("-h") && !isIdentifierRegistered("--help"))
-            {
-                registerSwitch("help", {"-h", "--help"}, "Display usage text.", [this](){autohelper(this, std::cout);});
-                return true;
-            }
-            else throw std::runtime_error("Autohelp failure: A keyword is already registered.");
+    std::shared_ptr<const std::string> Parser::getHelpText(size_t width) const{
+        return parser_impl->schema->getHelpText(getProgramName(), width != 0? width : terminal_width(1));
+    };
+
+    void autohelper(const Parser& parser, std::ostream& stream, size_t width){
+        // Only the standard output is known to refer to a terminal.
+        if (width == 0) width = &stream == &std::cout? terminal_width(1) : DEFAULT_WIDTH;
+        std::shared_ptr<const std::string> text = parser.getHelpText(width);
+        stream.write(text->data(), (std::streamsize)text->size());
+        stream.flush();
+    };
+
+    void autohelper(const Parser* parser, std::ostream& stream, size_t width){
+        autohelper(*parser, stream, width);
+    };
+
+    void autohelper(const Parser& parser, int fd){
+        std::shared_ptr<const std::string> text = parser.getHelpText(terminal_width(fd));
+
+        // The text is written at once, but a write to a pipe may still be
+        // split, in which case the rest is written afterwards.
+        const char* data = text->data();
+        size_t remaining = text->size();
+        while (remaining > 0) {
+        #ifdef _WIN32
+            int count = _write(fd, data, (unsigned int)std::min<size_t>(remaining, 1 << 30));
+        #else
+            ssize_t count = write(fd, data, remaining);
+        #endif
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) return;
+            data += count;
+            remaining -= (size_t)count;
         }
-        catch (const std::exception& e){
-            setError(e.what());
-            return false;
+    };
+
+    bool Parser::enableAutohelp(){
+        // First test if both switches and the name are available.
+        // As there is a distinct possibility of this method being the first
+        // to register anything, we can speed up this test by checking if
+        // nothing has been registered yet.
+        if ( !isNameRegistered("help") && !isIdentifierRegistered("-h") && !isIdentifierRegistered("--help"))
+        {
+            registerSwitch("help", {"-h", "--help"}, "Display usage text.", [this](){
+                std::cout.flush();
+                autohelper(*this, 1);
+                exit(0);
+            });
+            return true;
         }
+        setError("Autohelp failure: A keyword is already registered.");
+        return false;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,50 @@
+/**
+ * batch.cpp
+ * 
+ * This file contains the implementation of the batch parsing interface.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <algorithm>
+#include <argsparser/batch.h>
+
+namespace ArgsParser
+{
+    std::vector<BatchResult> parseBatch(
+        const CompiledSchema& schema,
+        const std::vector<std::vector<std::string>>& lines,
+        size_t threads,
+        const ParseOptions& options
+    ){
+        ThreadPool pool(std::max<size_t>(std::min(threads != 0? threads : std::thread::hardware_concurrency(), lines.size()), 1));
+        return parseBatch(schema, lines, pool, options);
+    };
+
+    std::vector<BatchResult> parseBatch(
+        const CompiledSchema& schema,
+        const std::vector<std::vector<std::string>>& lines,
+        ThreadPool& pool,
+        const ParseOptions& options
+    ){
+        std::vector<BatchResult> results(lines.size());
+        pool.run(lines.size(), [&schema, &lines, &options, &results](size_t index){
+            const std::vector<std::string>& line = lines[index];
+            BatchResult& entry = results[index];
+
+            // The parser never writes to argv, so it can point into the lines.
+            std::vector<char*> argv(line.size() + 1, nullptr);
+            for (size_t i = 0; i < line.size(); i++) argv[i] = const_cast<char*>(line[i].c_str());
+
+            try {
+                entry.result = schema.parse((int)line.size(), argv.data(), options);
+                entry.success = true;
+            }
+            catch (const std::exception& e) {
+                entry.success = false;
+                entry.error = e.what();
+            }
+        });
+        return results;
+    };
+}
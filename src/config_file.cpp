@@ -0,0 +1,98 @@
+/**
+ * config_file.cpp
+ *
+ * This file contains the implementation of the ConfigFile class.
+ *
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <argsparser/config_file.h>
+
+namespace
+{
+    // Returns a string without its surrounding whitespace.
+    inline std::string_view trim(std::string_view string){
+        size_t first = string.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos) return std::string_view();
+        size_t last = string.find_last_not_of(" \t\r");
+        return string.substr(first, last - first + 1);
+    }
+}
+
+namespace ArgsParser
+{
+    ConfigFile::ConfigFile(const std::string& path) :
+        file_(path),
+        data_(file_.data())
+        { };
+
+    Span<std::string_view> ConfigFile::find(std::string_view key) const{
+        std::call_once(read_, [this](){ read(); });
+
+        auto lookup = [this](const Entry& entry){
+            auto range = std::equal_range(entries_.begin(), entries_.end(), entry, [](const Entry& a, const Entry& b){
+                return a.section != b.section? a.section < b.section : a.key < b.key;
+            });
+            return Span<std::string_view>(values_.data() + (range.first - entries_.begin()), (size_t)(range.second - range.first));
+        };
+
+        // The section is everything before the last dot. Keys given before
+        // any section may contain dots themselves, so the whole key is looked
+        // up outside of any section if no section has it.
+        size_t dot = key.rfind('.');
+        if (dot != std::string_view::npos) {
+            Span<std::string_view> values = lookup(Entry{key.substr(0, dot), key.substr(dot + 1)});
+            if (values.size() != 0) return values;
+        }
+        return lookup(Entry{std::string_view(), key});
+    };
+
+    void ConfigFile::read() const{
+        std::vector<Entry> entries;
+        std::vector<std::string_view> values;
+        std::string_view contents(data_, file_.size());
+        std::string_view section;
+
+        while (!contents.empty()) {
+            size_t end = contents.find('\n');
+            std::string_view line = trim(contents.substr(0, end));
+            contents = end == std::string_view::npos? std::string_view() : contents.substr(end + 1);
+            if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+
+            if (line[0] == '[') {
+                size_t close = line.find(']');
+                if (close != std::string_view::npos) section = trim(line.substr(1, close - 1));
+                continue;
+            }
+
+            // Lines without a separator are ignored, as are empty keys.
+            size_t separator = line.find('=');
+            if (separator == std::string_view::npos) continue;
+            std::string_view key = trim(line.substr(0, separator));
+            std::string_view value = trim(line.substr(separator + 1));
+            if (key.empty()) continue;
+            if (value.size() >= 2 && (value[0] == '"' || value[0] == '\'') && value.back() == value[0])
+                value = value.substr(1, value.size() - 2);
+            entries.push_back(Entry{section, key});
+            values.push_back(value);
+        }
+
+        // Sort the entries, keeping those of the same key in file order, and
+        // move their values along with them.
+        std::vector<size_t> order(entries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&entries](size_t a, size_t b){
+            const Entry& first = entries[a];
+            const Entry& second = entries[b];
+            return first.section != second.section? first.section < second.section : first.key < second.key;
+        });
+        entries_.reserve(order.size());
+        values_.reserve(order.size());
+        for (size_t i : order) {
+            entries_.push_back(entries[i]);
+            values_.push_back(values[i]);
+        }
+    };
+}
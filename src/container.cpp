@@ -8,40 +8,100 @@
 
 #include <argsparser/container.h>
 
+namespace
+{
+    // Copies a list of identifiers into a list allocated from a memory resource.
+    std::pmr::vector<std::pmr::string> copy_identifiers(
+        const std::vector<std::string>& identifiers,
+        std::pmr::memory_resource* resource
+    ){
+        std::pmr::vector<std::pmr::string> copy(resource);
+        copy.reserve(identifiers.size());
+        for (size_t i = 0; i < identifiers.size(); i++)
+            copy.emplace_back(identifiers[i].data(), identifiers[i].size());
+        return copy;
+    }
+}
+
 namespace ArgsParser
 {
+    ContainerState::ContainerState(std::pmr::memory_resource* resource) :
+        active(false),
+        resource(resolve(resource)) { };
+
+    ContainerState::ContainerState(const ContainerState& other, std::pmr::memory_resource* resource) :
+        active(other.active),
+        resource(resolve(resource)) { };
+
+    ContainerState::~ContainerState(){
+
+    }
+
+    ContainerState* ContainerState::clone() const{
+        return create<ContainerState>(resource, *this);
+    }
+
+    void ContainerState::destroy() noexcept{
+        dispose(this, resource);
+    }
+
     Container::Container(
         const ArgType type,
         const std::string& name,
         const std::vector<std::string>& identifiers,
         const std::string& description,
-        const Callback& callback
+        const Callback& callback,
+        std::pmr::memory_resource* resource
+        ) :
+        name_(name.data(), name.size(), resolve(resource)),
+        description_(description.data(), description.size(), resolve(resource)),
+        identifiers_(copy_identifiers(identifiers, resolve(resource))),
+        callback_(callback),
+        type_(type) { };
+
+    Container::Container(
+        const ArgType type,
+        const std::string& name,
+        std::pmr::vector<std::pmr::string>&& identifiers,
+        const std::string& description,
+        const Callback& callback,
+        std::pmr::memory_resource* resource
         ) :
-        type_(type),
-        name_(name),
-        identifiers_(identifiers),
-        description_(description),
+        name_(name.data(), name.size(), resolve(resource)),
+        description_(description.data(), description.size(), resolve(resource)),
+        identifiers_(std::move(identifiers), resolve(resource)),
         callback_(callback),
-        active_(false) { };
+        type_(type) { };
+
+    Container::Container(const Container& other, std::pmr::memory_resource* resource) :
+        name_(other.name_, resolve(resource)),
+        description_(other.description_, resolve(resource)),
+        identifiers_(other.identifiers_, resolve(resource)),
+        callback_(other.callback_),
+        type_(other.type_) { };
 
     Container::~Container(){
 
     }
 
-    Container* Container::clone() const{
-        Container* copy = new Container(
-            type_,
-            name_,
-            identifiers_,
-            description_,
-            callback_
-        );
-        copy->active_ = active_;
-        return copy;
+    Container* Container::clone(std::pmr::memory_resource* resource) const{
+        return create<Container>(resource != nullptr? resource : getMemoryResource(), *this);
+    }
+
+    void Container::destroy() noexcept{
+        dispose(this, getMemoryResource());
+    }
+
+    std::pmr::memory_resource* Container::getMemoryResource() const noexcept{
+        return identifiers_.get_allocator().resource();
+    }
+
+    ContainerState* Container::createState(std::pmr::memory_resource* resource) const{
+        return create<ContainerState>(resource);
     }
 
     std::string Container::getName() const noexcept{
-        return name_;
+        return std::string(name_);
     };
 
     ArgType Container::getType() const noexcept{
@@ -49,22 +109,34 @@ namespace ArgsParser
     }
 
     std::string Container::getDescription() const noexcept{
-        return description_;
+        return std::string(description_);
     };
 
     std::vector<std::string> Container::getIdentifiers() const noexcept{
-        return identifiers_;
+        return std::vector<std::string>(identifiers_.begin(), identifiers_.end());
     };
 
-    bool Container::isActive() const noexcept{
-        return active_;
+    void Container::setActive(ContainerState& state) const{
+        state.active = true;
+    };
+
+    void Container::postProcess(ContainerState&) const{
+        if(callback_ != nullptr) ARGSPARSER_TIME_ARGUMENT(callback_ns, callback_());
+    };
+
+    size_t Container::prepare(ContainerState&, size_t) const{
+        return 0;
+    };
+
+    void Container::process(ContainerState&, size_t) const{
+
     };
 
-    void Container::setActive(){
-        active_ = true;
+    void Container::complete(ContainerState& state) const{
+        postProcess(state);
     };
 
-    void Container::postProcess(){
-        if(callback_ != nullptr) callback_();
+    bool Container::hasAsyncValidator() const noexcept{
+        return false;
     };
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+/**
+ * identifier_table.cpp
+ * 
+ * This file contains the implementation of the IdentifierTable class.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <argsparser/identifier_table.h>
+
+namespace ArgsParser
+{
+    IdentifierTable::IdentifierTable(std::pmr::memory_resource* resource) :
+        keys_(resolve(resource)),
+        entries_(keys_.get_allocator()),
+        displacements_(keys_.get_allocator())
+        { };
+
+    IdentifierTable::IdentifierTable(const IdentifierTable& other, std::pmr::memory_resource* resource) :
+        keys_(other.keys_, resolve(resource)),
+        entries_(other.entries_, keys_.get_allocator()),
+        displacements_(other.displacements_, keys_.get_allocator())
+        { };
+
+    void IdentifierTable::build(const std::vector<std::pair<std::string_view, Token>>& identifiers){
+        const size_t count = identifiers.size();
+
+        keys_.clear();
+        entries_.assign(count, Entry());
+        displacements_.assign(std::max<size_t>(count, 1), 0);
+        if (count == 0) return;
+
+        // Strip every identifier of its dashes and hash it.
+        std::vector<Entry> sources(count);
+        std::vector<uint64_t> hashes(count);
+        for (size_t i = 0; i < count; i++) {
+            const std::string_view& identifier = identifiers[i].first;
+            size_t first_char = identifier.find_first_not_of('-');
+            if (first_char == std::string_view::npos) first_char = identifier.size();
+
+            sources[i].offset = (uint32_t)keys_.size();
+            sources[i].length = (uint32_t)(identifier.size() - first_char);
+            sources[i].token = identifiers[i].second;
+            keys_.insert(keys_.end(), identifier.begin() + first_char, identifier.end());
+            hashes[i] = Detail::hashBytes(identifier.data() + first_char, sources[i].length);
+        }
+
+        // Distribute the keys into buckets, and place the largest buckets first
+        // as they are the hardest to fit.
+        const size_t bucket_count = displacements_.size();
+        std::vector<std::vector<uint32_t>> buckets(bucket_count);
+        for (size_t i = 0; i < count; i++) {
+            buckets[Detail::bucketOf(hashes[i], bucket_count)].push_back((uint32_t)i);
+        }
+        std::vector<uint32_t> order(bucket_count);
+        for (size_t i = 0; i < bucket_count; i++) order[i] = (uint32_t)i;
+        std::stable_sort(order.begin(), order.end(), [&buckets](uint32_t a, uint32_t b){
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        std::vector<bool> occupied(count, false);
+        std::vector<size_t> placement;
+        size_t position = 0;
+
+        // Find a seed for every bucket with more than one key such that all its
+        // keys hash to free slots.
+        for (; position < bucket_count && buckets[order[position]].size() > 1; position++) {
+            const std::vector<uint32_t>& bucket = buckets[order[position]];
+            int32_t seed = 1;
+            for (;;) {
+                placement.clear();
+                size_t i = 0;
+                for (; i < bucket.size(); i++) {
+                    size_t slot = Detail::slotOf(hashes[bucket[i]], seed, count);
+                    if (occupied[slot] || std::find(placement.begin(), placement.end(), slot) != placement.end())
+                        break;
+                    placement.push_back(slot);
+                }
+                if (i == bucket.size()) break;
+                if (seed == std::numeric_limits<int32_t>::max())
+                    throw std::runtime_error("Unable to build identifier table (duplicate identifier).");
+                seed++;
+            }
+            displacements_[order[position]] = seed;
+            for (size_t i = 0; i < bucket.size(); i++) {
+                occupied[placement[i]] = true;
+                entries_[placement[i]] = sources[bucket[i]];
+            }
+        }
+
+        // Buckets with a single key point straight to any free slot.
+        size_t free_slot = 0;
+        for (; position < bucket_count && buckets[order[position]].size() == 1; position++) {
+            while (occupied[free_slot]) free_slot++;
+            occupied[free_slot] = true;
+            displacements_[order[position]] = -(int32_t)free_slot - 1;
+            entries_[free_slot] = sources[buckets[order[position]][0]];
+        }
+    };
+
+    Token IdentifierTable::find(const char* identifier) const noexcept{
+        while (*identifier == '-') identifier++;
+
+        // Hash and measure the string in a single pass.
+        uint64_t hash = Detail::FNV_OFFSET;
+        const char* end = identifier;
+        for (; *end != '\0'; end++) {
+            hash ^= (unsigned char)*end;
+            hash *= Detail::FNV_PRIME;
+        }
+        return match(identifier, (size_t)(end - identifier), hash);
+    };
+
+    Token IdentifierTable::find(const char* identifier, size_t length) const noexcept{
+        while (length > 0 && *identifier == '-') {
+            identifier++;
+            length--;
+        }
+        return match(identifier, length, Detail::hashBytes(identifier, length));
+    };
+
+    size_t IdentifierTable::size() const noexcept{
+        return entries_.size();
+    };
+
+    Token IdentifierTable::match(const char* key, size_t length, uint64_t hash) const noexcept{
+        if (entries_.empty()) return NULL_TOKEN;
+
+        int32_t displacement = displacements_[Detail::bucketOf(hash, displacements_.size())];
+        size_t slot = displacement < 0?
+            (size_t)(-displacement - 1) : Detail::slotOf(hash, displacement, entries_.size());
+
+        const Entry& entry = entries_[slot];
+        if (entry.length == length && std::memcmp(keys_.data() + entry.offset, key, length) == 0)
+            return entry.token;
+        return NULL_TOKEN;
+    };
+}
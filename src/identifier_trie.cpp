@@ -0,0 +1,214 @@
+/**
+ * identifier_trie.cpp
+ *
+ * This file contains the implementation of the IdentifierTrie class.
+ *
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <algorithm>
+#include <argsparser/identifier_trie.h>
+
+namespace
+{
+    // Returns an identifier without its prefixing dashes.
+    inline std::string_view strip_dashes(std::string_view identifier){
+        size_t first_char = identifier.find_first_not_of('-');
+        return first_char == std::string_view::npos? std::string_view() : identifier.substr(first_char);
+    }
+}
+
+namespace ArgsParser
+{
+    IdentifierTrie::IdentifierTrie(std::pmr::memory_resource* resource) :
+        nodes_(resolve(resource)),
+        edges_(nodes_.get_allocator()),
+        size_(0),
+        depth_(0)
+        { };
+
+    IdentifierTrie::IdentifierTrie(const IdentifierTrie& other, std::pmr::memory_resource* resource) :
+        nodes_(other.nodes_, resolve(resource)),
+        edges_(other.edges_, nodes_.get_allocator()),
+        size_(other.size_),
+        depth_(other.depth_)
+        { };
+
+    void IdentifierTrie::build(const std::vector<std::pair<std::string_view, Token>>& identifiers){
+        nodes_.clear();
+        edges_.clear();
+        size_ = identifiers.size();
+        depth_ = 0;
+        if (identifiers.empty()) return;
+
+        // Sorting the keys places those sharing a prefix next to each other,
+        // with the shortest first, so every node covers a contiguous range.
+        std::vector<std::pair<std::string_view, Token>> keys(identifiers.size());
+        for (size_t i = 0; i < identifiers.size(); i++)
+            keys[i] = std::make_pair(strip_dashes(identifiers[i].first), identifiers[i].second);
+        std::sort(keys.begin(), keys.end(), [](const std::pair<std::string_view, Token>& a, const std::pair<std::string_view, Token>& b){
+            return a.first < b.first;
+        });
+
+        // Every key adds at most one node per character.
+        size_t characters = 0;
+        for (size_t i = 0; i < keys.size(); i++) characters += keys[i].first.size();
+        nodes_.reserve(characters + 1);
+        edges_.reserve(characters);
+        insert(keys, 0, keys.size(), 0);
+    };
+
+    uint32_t IdentifierTrie::insert(const std::vector<std::pair<std::string_view, Token>>& keys, size_t first, size_t last, size_t depth){
+        const uint32_t index = (uint32_t)nodes_.size();
+        nodes_.push_back(Node{0, 0, NULL_TOKEN, keys[first].second});
+        depth_ = std::max(depth_, depth);
+
+        for (size_t i = first + 1; i < last; i++) {
+            if (!(keys[i].second == nodes_[index].unique)) {
+                nodes_[index].unique = NULL_TOKEN;
+                break;
+            }
+        }
+        if (keys[first].first.size() == depth) nodes_[index].token = keys[first++].second;
+
+        // Reserve the edges of the node before adding its children, so they
+        // are stored next to each other.
+        size_t groups = 0;
+        for (size_t i = first; i < last; groups++) {
+            const char label = keys[i].first[depth];
+            while (i < last && keys[i].first[depth] == label) i++;
+        }
+        const uint32_t first_edge = (uint32_t)edges_.size();
+        nodes_[index].first_edge = first_edge;
+        nodes_[index].edge_count = (uint32_t)groups;
+        edges_.resize(edges_.size() + groups);
+
+        size_t edge = first_edge;
+        for (size_t i = first; i < last; edge++) {
+            const char label = keys[i].first[depth];
+            size_t end = i;
+            while (end < last && keys[end].first[depth] == label) end++;
+            uint32_t child = insert(keys, i, end, depth + 1);
+            edges_[edge].label = label;
+            edges_[edge].child = child;
+            i = end;
+        }
+        return index;
+    };
+
+    const IdentifierTrie::Node* IdentifierTrie::child(const Node& node, char label) const noexcept{
+        const Edge* first = edges_.data() + node.first_edge;
+        const Edge* last = first + node.edge_count;
+        const Edge* edge = std::lower_bound(first, last, label, [](const Edge& edge, char value){
+            return edge.label < value;
+        });
+        return edge != last && edge->label == label? &nodes_[edge->child] : nullptr;
+    };
+
+    Token IdentifierTrie::matchPrefix(const char* identifier, size_t length) const noexcept{
+        while (length > 0 && *identifier == '-') {
+            identifier++;
+            length--;
+        }
+        if (nodes_.empty() || length < 2) return NULL_TOKEN;
+
+        const Node* node = &nodes_[0];
+        for (size_t i = 0; i < length && node != nullptr; i++) node = child(*node, identifier[i]);
+        if (node == nullptr) return NULL_TOKEN;
+
+        // An identifier that is also the prefix of others matches itself.
+        return node->token? node->token : node->unique;
+    };
+
+    std::vector<std::string> IdentifierTrie::suggest(std::string_view identifier, size_t max_distance, size_t max_results) const{
+        std::vector<std::string> suggestions;
+        if (nodes_.empty() || max_results == 0) return suggestions;
+
+        const std::string_view key = strip_dashes(identifier);
+        const size_t columns = key.size() + 1;
+        const size_t limit = max_distance + 1;
+
+        // The distances between the key and the path to the node at each
+        // depth, one row per depth, as in the Wagner-Fischer algorithm. Only
+        // the cells within max_distance of the diagonal can be small enough
+        // to matter, so the others are left at the limit and never updated.
+        std::vector<size_t> rows((depth_ + 1) * columns, limit);
+        std::vector<size_t> minimums(depth_ + 1, 0);
+        for (size_t j = 0; j < columns && j < limit; j++) rows[j] = j;
+        std::string path;
+        std::vector<std::pair<size_t, std::string>> found;
+
+        struct Frame{
+            uint32_t node;
+            uint32_t next_edge;
+        };
+        std::vector<Frame> stack;
+        stack.push_back(Frame{0, 0});
+
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            const Node& node = nodes_[frame.node];
+            if (frame.next_edge == node.edge_count) {
+                stack.pop_back();
+                if (!path.empty()) path.pop_back();
+                continue;
+            }
+            const Edge& edge = edges_[node.first_edge + frame.next_edge++];
+
+            // Compute the row of the child from those of its ancestors.
+            const size_t depth = path.size() + 1;
+            const size_t* above = &rows[(depth - 1) * columns];
+            const size_t* swapped = depth > 1? &rows[(depth - 2) * columns] : nullptr;
+            size_t* row = &rows[depth * columns];
+            const size_t first = depth > max_distance? depth - max_distance : 1;
+            const size_t last = std::min(columns - 1, depth + max_distance);
+            size_t row_minimum = limit;
+            if (depth < limit) row_minimum = row[0] = depth;
+            for (size_t j = first; j <= last; j++) {
+                size_t distance = above[j - 1] + (key[j - 1] == edge.label? 0 : 1);
+                if (above[j] + 1 < distance) distance = above[j] + 1;
+                if (row[j - 1] + 1 < distance) distance = row[j - 1] + 1;
+                if (swapped != nullptr && j > 1 && key[j - 1] == path.back() && key[j - 2] == edge.label && swapped[j - 2] + 1 < distance)
+                    distance = swapped[j - 2] + 1;
+                row[j] = distance < limit? distance : limit;
+                if (row[j] < row_minimum) row_minimum = row[j];
+            }
+            minimums[depth] = row_minimum;
+
+            const Node& next = nodes_[edge.child];
+            if (next.token && row[columns - 1] <= max_distance && row[columns - 1] > 0) {
+                std::string suggestion = depth == 1? "-" : "--";
+                suggestion += path;
+                suggestion += edge.label;
+                found.emplace_back(row[columns - 1], std::move(suggestion));
+            }
+
+            // Swapping the label of the edge with the next character of the
+            // path may still bring the distance down, so the subtree is only
+            // skipped if no such swap can be within the distance either.
+            size_t swap_minimum = limit;
+            if (row_minimum > max_distance && minimums[depth - 1] + 1 <= max_distance) {
+                const size_t swap_first = depth + 1 > max_distance? depth + 1 - max_distance : 2;
+                const size_t swap_last = std::min(columns - 1, depth + 1 + max_distance);
+                for (size_t j = std::max<size_t>(swap_first, 2); j <= swap_last; j++)
+                    if (key[j - 1] == edge.label && above[j - 2] < swap_minimum) swap_minimum = above[j - 2];
+            }
+            if (std::min(row_minimum, swap_minimum + 1) <= max_distance && next.edge_count > 0) {
+                path.push_back(edge.label);
+                stack.push_back(Frame{edge.child, 0});
+            }
+        }
+
+        // Identifiers were found in order, so those at the same distance
+        // stay sorted.
+        std::stable_sort(found.begin(), found.end(), [](const std::pair<size_t, std::string>& a, const std::pair<size_t, std::string>& b){
+            return a.first < b.first;
+        });
+        for (size_t i = 0; i < found.size() && i < max_results; i++) suggestions.push_back(std::move(found[i].second));
+        return suggestions;
+    };
+
+    size_t IdentifierTrie::size() const noexcept{
+        return size_;
+    };
+}
@@ -10,6 +10,47 @@
 
 namespace ArgsParser
 {
+    InputState::InputState(std::pmr::memory_resource* resource) :
+        ContainerState(resource),
+        user_input(this->resource),
+        validation(false),
+        validation_failure_reason("No input value."),
+        part_size(0)
+    { };
+
+    InputState::InputState(const InputState& other, std::pmr::memory_resource* resource) :
+        ContainerState(other, resource),
+        user_input(other.user_input, this->resource),
+        validation(other.validation),
+        validation_failure_reason(other.validation_failure_reason),
+        part_size(0)
+    { };
+
+    InputState::~InputState(){
+
+    }
+
+    InputState* InputState::clone() const{
+        return create<InputState>(resource, *this);
+    }
+
+    void InputState::destroy() noexcept{
+        dispose(this, resource);
+    }
+
+    ValueWrapper InputState::getValue() const noexcept{
+        return {std::vector<std::string>(user_input.begin(), user_input.end()), active};
+    };
+
+    std::pair<bool, std::string> InputState::getValidation() const noexcept{
+        forceConversion();
+        return std::make_pair(validation, validation_failure_reason);
+    };
+
+    void InputState::forceConversion() const{
+
+    };
+
     InputContainer::InputContainer(
         const ArgType type,
         const std::string& name,
@@ -19,84 +60,202 @@ namespace ArgsParser
         const size_t max_values,
         const Validator<std::string>& validator,
         const ErrorHandler& error_callback,
-        const Callback& callback
-    ) : Container(type, name, identifiers, description, callback),
-        placeholder_text_(placeholder_text),
+        const Callback& callback,
+        std::pmr::memory_resource* resource
+    ) : Container(type, name, identifiers, description, callback, resource),
+        placeholder_text_(placeholder_text.data(), placeholder_text.size(), resolve(resource)),
+        max_values_(max_values),
+        lazy_(false),
+        validator_(validator),
+        error_callback_(error_callback),
+        environment_(resolve(resource)),
+        config_key_(resolve(resource)),
+        default_value_(resolve(resource)),
+        has_default_(false)
+    { };
+
+    InputContainer::InputContainer(
+        const ArgType type,
+        const std::string& name,
+        std::pmr::vector<std::pmr::string>&& identifiers,
+        const std::string& description,
+        const std::string& placeholder_text,
+        const size_t max_values,
+        const Validator<std::string>& validator,
+        const ErrorHandler& error_callback,
+        const Callback& callback,
+        std::pmr::memory_resource* resource
+    ) : Container(type, name, std::move(identifiers), description, callback, resource),
+        placeholder_text_(placeholder_text.data(), placeholder_text.size(), resolve(resource)),
         max_values_(max_values),
+        lazy_(false),
         validator_(validator),
         error_callback_(error_callback),
-        validation_(false),
-        validation_failure_reason_("No input value.")
+        environment_(resolve(resource)),
+        config_key_(resolve(resource)),
+        default_value_(resolve(resource)),
+        has_default_(false)
+    { };
+
+    InputContainer::InputContainer(const InputContainer& other, std::pmr::memory_resource* resource) :
+        Container(other, resource),
+        placeholder_text_(other.placeholder_text_, resolve(resource)),
+        max_values_(other.max_values_),
+        lazy_(other.lazy_),
+        validator_(other.validator_),
+        error_callback_(other.error_callback_),
+        environment_(other.environment_, resolve(resource)),
+        config_key_(other.config_key_, resolve(resource)),
+        default_value_(other.default_value_, resolve(resource)),
+        has_default_(other.has_default_)
     { };
 
     InputContainer::~InputContainer(){
 
     }
 
-    InputContainer* InputContainer::clone() const{
-        InputContainer* copy = new InputContainer(
-            type_,
-            name_,
-            identifiers_,
-            description_,
-            placeholder_text_,
-            max_values_,
-            validator_,
-            error_callback_,
-            callback_
-        );
-        copy->user_input_ = user_input_;
-        copy->validation_ = validation_;
-        copy->validation_failure_reason_ = validation_failure_reason_;
-        return copy;
+    InputContainer* InputContainer::clone(std::pmr::memory_resource* resource) const{
+        return create<InputContainer>(resource != nullptr? resource : getMemoryResource(), *this);
+    }
+
+    void InputContainer::destroy() noexcept{
+        dispose(this, getMemoryResource());
+    }
+
+    InputState* InputContainer::createState(std::pmr::memory_resource* resource) const{
+        return create<InputState>(resource);
     }
 
     std::string InputContainer::getPlaceholderText() const noexcept{
-        return placeholder_text_;
+        return std::string(placeholder_text_);
     };
 
-    std::vector<std::string> InputContainer::getUserInput() const noexcept{
-        return user_input_;
+    size_t InputContainer::getMaxInputs() const noexcept{
+        return max_values_;
     };
 
-    size_t InputContainer::getInputSize() const noexcept{
-        return user_input_.size();
+    bool InputContainer::isLazy() const noexcept{
+        return lazy_;
     };
 
-    size_t InputContainer::getMaxInputs() const noexcept{
-        return max_values_;
+    bool InputContainer::hasFallback() const noexcept{
+        return !environment_.empty() || !config_key_.empty() || has_default_;
+    };
+
+    void InputContainer::setActive(InputState& state, std::string_view input) const{
+        if(!state.active) {
+            Container::setActive(state);
+            // Reserve room for the expected inputs up front, so they are not
+            // reallocated as each one is parsed.
+            state.user_input.reserve(std::min<size_t>(max_values_, 16));
+        }
+        state.user_input.push_back(input);
+    };
+
+    void InputContainer::postProcess(ContainerState& container_state) const{
+        InputState& state = static_cast<InputState&>(container_state);
+        std::string reason;
+        const size_t size = state.user_input.size();
+        state.validation = validate(state, 0, size, reason) == size;
+        state.validation_failure_reason = state.validation? "" : std::move(reason);
+        report(state);
     };
 
-    ValueWrapper InputContainer::getValue() const noexcept{
-        return {user_input_, active_};
+    size_t InputContainer::prepare(ContainerState& container_state, size_t part_size) const{
+        InputState& state = static_cast<InputState&>(container_state);
+        const size_t size = state.user_input.size();
+        state.part_size = std::max<size_t>(part_size, 1);
+        state.parts.resize(size == 0? 0 : (size - 1) / state.part_size + 1);
+        return state.parts.size();
     };
 
-    std::pair<bool, std::string> InputContainer::getValidation() const noexcept{
-        return std::make_pair(validation_, validation_failure_reason_);
+    void InputContainer::process(ContainerState& container_state, size_t part) const{
+        InputState& state = static_cast<InputState&>(container_state);
+        const size_t first = part * state.part_size;
+        const size_t last = std::min(first + state.part_size, state.user_input.size());
+        InputState::Part& result = state.parts[part];
+        if (!validator_.isAsync()) {
+            result.rejected = validate(state, first, last, result.reason);
+            return;
+        }
+
+        // The validator is given copies of the inputs, which must not move
+        // until it is done with them.
+        result.rejected = last;
+        result.inputs.reserve(last - first);
+        result.pending.reserve(last - first);
+        for (size_t i = first; i < last; i++) {
+            result.inputs.emplace_back(state.user_input[i]);
+            result.pending.push_back(InputState::PendingValidation{i, i - first, validator_.start(result.inputs.back())});
+        }
+    };
+
+    void InputContainer::complete(ContainerState& container_state) const{
+        InputState& state = static_cast<InputState&>(container_state);
+
+        // Parts are checked in order, so the error reported is the same as
+        // that of a sequential parse.
+        state.validation = true;
+        state.validation_failure_reason = "";
+        for (size_t i = 0; i < state.parts.size(); i++) await(state.parts[i]);
+        for (size_t i = 0; i < state.parts.size(); i++) {
+            if (state.parts[i].rejected < std::min((i + 1) * state.part_size, state.user_input.size())) {
+                state.validation = false;
+                state.validation_failure_reason = std::move(state.parts[i].reason);
+                break;
+            }
+        }
+        state.parts.clear();
+        report(state);
     };
 
-    void InputContainer::setActive(const std::string& input){
-        if(!active_) Container::setActive();
-        user_input_.push_back(input);
+    bool InputContainer::hasAsyncValidator() const noexcept{
+        return validator_.isAsync();
     };
 
-    void InputContainer::postProcess(){
-        if (validator_ != nullptr) {
-            for (size_t i = 0; i < user_input_.size(); i++) {
-                try{
-                    bool valid = validator_(user_input_[i]);
-                    if (!valid) throw std::runtime_error("Unspecified validation error.");
-                }
-                catch (std::exception& e) {
-                    validation_ = false;
-                    validation_failure_reason_ = e.what();
-                    
-                    if (error_callback_ != nullptr) error_callback_(e);
-                    return;
-                }
+    size_t InputContainer::await(InputState::Part& part) const{
+        // Every validation is awaited, even after one fails, as each may
+        // still refer to its value.
+        size_t rejected_value = std::string::npos;
+        size_t input = std::string::npos;
+        size_t first_value = 0;
+        for (size_t i = 0; i < part.pending.size(); i++) {
+            InputState::PendingValidation& validation = part.pending[i];
+            if (validation.input != input) {
+                input = validation.input;
+                first_value = validation.value;
+            }
+            Status status = ARGSPARSER_TIME_ARGUMENT(validator_ns, Detail::awaitStatus(validation.result));
+            if (!status && validation.input < part.rejected) {
+                part.rejected = validation.input;
+                part.reason = status.error();
+                rejected_value = first_value;
             }
         }
-        if (callback_ != nullptr) callback_();
+        part.pending.clear();
+        part.inputs.clear();
+        return rejected_value;
+    };
 
+    size_t InputContainer::validate(const InputState& state, size_t first, size_t last, std::string& reason) const{
+        if (validator_ == nullptr) return last;
+        for (size_t i = first; i < last; i++) {
+            Status status = ARGSPARSER_TIME_ARGUMENT(validator_ns, validator_(std::string(state.user_input[i])));
+            if (!status) {
+                reason = status.error();
+                return i;
+            }
+        }
+        return last;
+    };
+
+    void InputContainer::report(const InputState& state) const{
+        if (!state.validation) {
+            // The error is passed to the handler without being thrown.
+            if (error_callback_ != nullptr)
+                ARGSPARSER_TIME_ARGUMENT(callback_ns, error_callback_(std::runtime_error(state.validation_failure_reason)));
+            return;
+        }
+        if (callback_ != nullptr) ARGSPARSER_TIME_ARGUMENT(callback_ns, callback_());
     };
 }
\ No newline at end of file
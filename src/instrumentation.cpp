@@ -0,0 +1,20 @@
+/**
+ * instrumentation.cpp
+ *
+ * This file contains the definitions of the state used to record the
+ * statistics of a parse.
+ *
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <argsparser/instrumentation.h>
+
+namespace ArgsParser
+{
+#ifdef ARGSPARSER_INSTRUMENTATION
+    namespace Detail
+    {
+        thread_local ArgumentStatistics* current_argument = nullptr;
+    }
+#endif
+}
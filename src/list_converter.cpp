@@ -0,0 +1,280 @@
+/**
+ * list_converter.cpp
+ * 
+ * This file contains the implementation of the vectorized scanning and
+ * parsing routines used by the ListConverter class.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <cstring>
+#include <argsparser/list_converter.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define ARGSPARSER_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#endif
+
+// Eight digits are parsed at once by reading them as a little-endian word.
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    #define ARGSPARSER_LITTLE_ENDIAN
+#endif
+
+namespace ArgsParser
+{
+namespace Detail
+{
+    // Returns the index of the lowest set bit of a non-zero mask.
+    static inline unsigned lowestBit(uint32_t mask) noexcept{
+    #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (unsigned)index;
+    #else
+        return (unsigned)__builtin_ctz(mask);
+    #endif
+    }
+
+    // Appends the offset of every set bit of a mask to the positions.
+    static inline size_t storeBits(uint32_t mask, uint32_t offset, uint32_t* positions, size_t count) noexcept{
+        while (mask != 0) {
+            positions[count++] = offset + lowestBit(mask);
+            mask &= mask - 1;
+        }
+        return count;
+    }
+
+    static size_t findScalar(const char* data, size_t size, size_t offset, char delimiter, uint32_t* positions, size_t count) noexcept{
+        for (size_t i = offset; i < size; i++) {
+            if (data[i] == delimiter) positions[count++] = (uint32_t)i;
+        }
+        return count;
+    }
+
+#ifdef ARGSPARSER_X86
+    static size_t findSSE2(const char* data, size_t size, char delimiter, uint32_t* positions) noexcept{
+        const __m128i pattern = _mm_set1_epi8(delimiter);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+            count = storeBits(mask, (uint32_t)i, positions, count);
+        }
+        return findScalar(data, size, i, delimiter, positions, count);
+    }
+
+    #if defined(__GNUC__) || defined(__clang__)
+        #define ARGSPARSER_AVX2 __attribute__((target("avx2")))
+        #define ARGSPARSER_SSSE3 __attribute__((target("ssse3")))
+    #else
+        #ifdef __AVX2__
+            #define ARGSPARSER_AVX2
+        #endif
+        // MSVC allows SSSE3 intrinsics without enabling them.
+        #define ARGSPARSER_SSSE3
+    #endif
+
+    #ifdef ARGSPARSER_AVX2
+    ARGSPARSER_AVX2
+    static size_t findAVX2(const char* data, size_t size, char delimiter, uint32_t* positions) noexcept{
+        const __m256i pattern = _mm256_set1_epi8(delimiter);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern));
+            count = storeBits(mask, (uint32_t)i, positions, count);
+        }
+        return findScalar(data, size, i, delimiter, positions, count);
+    }
+    #endif
+
+    // Return whether the processor supports AVX2 and SSSE3. These are checked
+    // once.
+    static bool hasAVX2() noexcept{
+    #if defined(ARGSPARSER_AVX2) && (defined(__GNUC__) || defined(__clang__))
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    #elif defined(ARGSPARSER_AVX2)
+        return true;
+    #else
+        return false;
+    #endif
+    }
+
+    static bool hasSSSE3() noexcept{
+    #if defined(__GNUC__) || defined(__clang__)
+        static const bool supported = __builtin_cpu_supports("ssse3");
+        return supported;
+    #else
+        static const bool supported = [](){
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 9)) != 0;
+        }();
+        return supported;
+    #endif
+    }
+#endif
+
+    size_t findDelimiters(const char* data, size_t size, char delimiter, uint32_t* positions) noexcept{
+    #ifdef ARGSPARSER_X86
+        #ifdef ARGSPARSER_AVX2
+        if (hasAVX2()) return findAVX2(data, size, delimiter, positions);
+        #endif
+        return findSSE2(data, size, delimiter, positions);
+    #else
+        return findScalar(data, size, 0, delimiter, positions, 0);
+    #endif
+    }
+
+    // Parses at most 19 digits, eight at a time where possible.
+    static inline bool parseDigits(const char* begin, const char* end, uint64_t& value) noexcept{
+        size_t length = (size_t)(end - begin);
+        if (length == 0 || length > 19) return false;
+
+        uint64_t result = 0;
+    #ifdef ARGSPARSER_LITTLE_ENDIAN
+        for (; end - begin >= 8; begin += 8) {
+            uint64_t word;
+            std::memcpy(&word, begin, 8);
+
+            // Every byte must be in '0'..'9', that is, have a high nibble of 3
+            // both before and after adding 6.
+            if (((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) != 0x3333333333333333)
+                return false;
+
+            // Combine pairs of digits, then pairs of pairs, then the halves.
+            word = ((word & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+            word = ((word & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+            word = ((word & 0x0000FFFF0000FFFF) * 42949672960001) >> 32;
+            result = result * 100000000 + word;
+        }
+    #endif
+        for (; begin != end; begin++) {
+            unsigned digit = (unsigned)(unsigned char)*begin - '0';
+            if (digit > 9) return false;
+            result = result * 10 + digit;
+        }
+        value = result;
+        return true;
+    }
+
+#ifdef ARGSPARSER_X86
+    // Parses the last length digits before end, where length is at most 16,
+    // reading the 16 bytes before end at once.
+    ARGSPARSER_SSSE3
+    static inline bool parseSixteenDigits(const char* end, size_t length, uint64_t& value) noexcept{
+        const __m128i zero = _mm_set1_epi8('0');
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(end - 16));
+
+        // Replace the bytes before the number by zeros.
+        const __m128i index = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        __m128i leading = _mm_cmpgt_epi8(_mm_set1_epi8((char)(16 - length)), index);
+        chunk = _mm_or_si128(_mm_and_si128(leading, zero), _mm_andnot_si128(leading, chunk));
+
+        // Every byte must now be a digit.
+        __m128i digits = _mm_sub_epi8(chunk, zero);
+        __m128i valid = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+        if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+
+        // Combine pairs of digits, then pairs of pairs, then pairs of those,
+        // leaving the value of each half of the number.
+        __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+        __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+        quads = _mm_packs_epi32(quads, quads);
+        __m128i halves = _mm_madd_epi16(quads, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+
+        uint64_t high = (uint32_t)_mm_cvtsi128_si32(halves);
+        uint64_t low = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(halves, 4));
+        value = high * 100000000 + low;
+        return true;
+    }
+#endif
+
+    // Converts a parsed magnitude to a 64-bit integer, returning whether it
+    // fits.
+    static inline bool toInteger(uint64_t magnitude, bool negative, bool is_signed, uint64_t& value) noexcept{
+        if (is_signed && magnitude > (uint64_t)std::numeric_limits<int64_t>::max() + negative) return false;
+        value = negative? 0 - magnitude : magnitude;
+        return true;
+    }
+
+    static size_t parseScalar(
+        const char* block,
+        const uint32_t* ends,
+        size_t count,
+        const char* begin,
+        bool is_signed,
+        uint64_t* values
+    ) noexcept{
+        for (size_t i = 0; i < count; i++) {
+            const char* end = block + ends[i];
+            bool negative = is_signed && begin != end && *begin == '-';
+            uint64_t magnitude;
+            if (!parseDigits(begin + negative, end, magnitude) || !toInteger(magnitude, negative, is_signed, values[i])) return i;
+            begin = end + 1;
+        }
+        return count;
+    }
+
+#ifdef ARGSPARSER_X86
+    ARGSPARSER_SSSE3
+    static size_t parseSSSE3(
+        const char* lower,
+        const char* block,
+        const uint32_t* ends,
+        size_t count,
+        const char* begin,
+        bool is_signed,
+        uint64_t* values
+    ) noexcept{
+        for (size_t i = 0; i < count; i++) {
+            const char* end = block + ends[i];
+            bool negative = is_signed && begin != end && *begin == '-';
+            const char* digits = begin + negative;
+            size_t length = (size_t)(end - digits);
+            uint64_t magnitude;
+
+            // Numbers of up to 16 digits are parsed at once, and longer ones
+            // as their leading digits followed by the last 16. The bytes
+            // before the number must be part of the list to be read.
+            bool parsed;
+            if (length - 1 < 16 && end - lower >= 16) {
+                parsed = parseSixteenDigits(end, length, magnitude);
+            }
+            else if (length > 16 && length <= 19) {
+                uint64_t leading, trailing;
+                parsed = parseDigits(digits, end - 16, leading) && parseSixteenDigits(end, 16, trailing);
+                magnitude = leading * 10000000000000000 + trailing;
+            }
+            else {
+                parsed = parseDigits(digits, end, magnitude);
+            }
+            if (!parsed || !toInteger(magnitude, negative, is_signed, values[i])) return i;
+            begin = end + 1;
+        }
+        return count;
+    }
+#endif
+
+    size_t parseIntegers(
+        const char* lower,
+        const char* block,
+        const uint32_t* ends,
+        size_t count,
+        const char* begin,
+        bool is_signed,
+        uint64_t* values
+    ) noexcept{
+    #ifdef ARGSPARSER_X86
+        if (hasSSSE3()) return parseSSSE3(lower, block, ends, count, begin, is_signed, values);
+    #endif
+        return parseScalar(block, ends, count, begin, is_signed, values);
+    }
+}
+}
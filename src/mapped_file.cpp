@@ -0,0 +1,99 @@
+/**
+ * mapped_file.cpp
+ * 
+ * This file contains the implementation of the MappedFile class.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <stdexcept>
+#include <argsparser/mapped_file.h>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace ArgsParser
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& path) :
+        data_(nullptr),
+        size_(0),
+        mapping_(nullptr)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Unable to open file \"" + path + "\".");
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            throw std::runtime_error("Unable to read file \"" + path + "\".");
+        }
+        size_ = (size_t)size.QuadPart;
+
+        // Empty files can not be mapped, and have nothing to read anyway.
+        if (size_ > 0) {
+            mapping_ = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+            if (mapping_ != NULL) data_ = (char*)MapViewOfFile(mapping_, FILE_MAP_COPY, 0, 0, 0);
+        }
+        CloseHandle(file);
+        if (size_ > 0 && data_ == nullptr) {
+            if (mapping_ != NULL) CloseHandle(mapping_);
+            throw std::runtime_error("Unable to map file \"" + path + "\".");
+        }
+    };
+
+    MappedFile::~MappedFile(){
+        if (data_ != nullptr) UnmapViewOfFile(data_);
+        if (mapping_ != nullptr) CloseHandle(mapping_);
+    };
+#else
+    MappedFile::MappedFile(const std::string& path) :
+        data_(nullptr),
+        size_(0)
+    {
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            throw std::runtime_error("Unable to open file \"" + path + "\".");
+
+        struct stat status;
+        if (fstat(file, &status) != 0) {
+            close(file);
+            throw std::runtime_error("Unable to read file \"" + path + "\".");
+        }
+        size_ = (size_t)status.st_size;
+
+        // Empty files can not be mapped, and have nothing to read anyway.
+        if (size_ > 0) {
+            void* mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+            if (mapping != MAP_FAILED) {
+                data_ = (char*)mapping;
+                madvise(mapping, size_, MADV_SEQUENTIAL);
+            }
+        }
+        close(file);
+        if (size_ > 0 && data_ == nullptr)
+            throw std::runtime_error("Unable to map file \"" + path + "\".");
+    };
+
+    MappedFile::~MappedFile(){
+        if (data_ != nullptr) munmap(data_, size_);
+    };
+#endif
+
+    char* MappedFile::data() noexcept{
+        return data_;
+    };
+
+    size_t MappedFile::size() const noexcept{
+        return size_;
+    };
+}
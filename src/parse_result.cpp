@@ -0,0 +1,224 @@
+/**
+ * parse_result.cpp
+ * 
+ * This file contains the implementation of methods in the ParseResult class.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <argsparser/schemaImpl.h>
+
+namespace ArgsParser
+{
+    ParseResult::ParseResult() :
+        program_name_(""),
+        resource_(std::pmr::get_default_resource())
+        { };
+
+    ParseResult::ParseResult(const CompiledSchema& schema, std::pmr::memory_resource* resource) :
+        schema_(schema),
+        program_name_(""),
+        resource_(resolve(resource)),
+        positional_states_(schema.get()->registered_positionals.size()),
+        switch_states_(schema.get()->registered_switches.size()),
+        option_states_(schema.get()->registered_options.size())
+    {
+    #ifdef ARGSPARSER_INSTRUMENTATION
+        counter_ = std::make_shared<Detail::CountingResource>(resource_);
+        resource_ = counter_.get();
+        statistics_ = std::make_shared<ParseStatistics>();
+        statistics_->collected = true;
+    #endif
+    };
+
+    ParseResult::ParseResult(const ParseResult& other) :
+        schema_(other.schema_),
+        program_name_(other.program_name_),
+        resource_(other.resource_),
+    #ifdef ARGSPARSER_INSTRUMENTATION
+        counter_(other.counter_),
+        statistics_(other.statistics_),
+    #endif
+        buffers_(other.buffers_),
+        positional_states_(other.positional_states_.size()),
+        switch_states_(other.switch_states_.size()),
+        option_states_(other.option_states_.size()),
+        fallbacks_(other.fallbacks_)
+    {
+        // Deep copy every state that has been created.
+        const ArgType types[] = {ArgType::Positional, ArgType::Switch, ArgType::Option};
+        for (ArgType type : types) {
+            const std::vector<StatePointer>& source = *other.getStates(type);
+            std::vector<StatePointer>& destination = *getStates(type);
+            for (size_t i = 0; i < source.size(); i++) {
+                if (source[i]) destination[i].reset(source[i]->clone());
+            }
+        }
+    };
+
+    ParseResult::ParseResult(ParseResult&& other) :
+        ParseResult()
+    {
+        swap(*this, other);
+    };
+
+    ParseResult& ParseResult::operator=(ParseResult other){
+        swap(*this, other);
+        return *this;
+    };
+
+    ParseResult::~ParseResult(){
+
+    };
+
+    void swap(ParseResult& first, ParseResult& second){
+        using std::swap;
+
+        swap(first.schema_, second.schema_);
+        swap(first.program_name_, second.program_name_);
+        swap(first.resource_, second.resource_);
+    #ifdef ARGSPARSER_INSTRUMENTATION
+        swap(first.counter_, second.counter_);
+        swap(first.statistics_, second.statistics_);
+    #endif
+        swap(first.buffers_, second.buffers_);
+        swap(first.positional_states_, second.positional_states_);
+        swap(first.switch_states_, second.switch_states_);
+        swap(first.option_states_, second.option_states_);
+        swap(first.fallbacks_, second.fallbacks_);
+    };
+
+    std::vector<StatePointer>* ParseResult::getStates(ArgType type) noexcept{
+        return const_cast<std::vector<StatePointer>*>(
+            static_cast<const ParseResult*>(this)->getStates(type));
+    };
+
+    const std::vector<StatePointer>* ParseResult::getStates(ArgType type) const noexcept{
+        switch (type)
+        {
+            case ArgType::Positional:
+                return &positional_states_;
+            case ArgType::Switch:
+                return &switch_states_;
+            case ArgType::Option:
+                return &option_states_;
+            default:
+                return nullptr;
+        }
+    };
+
+    const ContainerState* ParseResult::getState(const Token& token) const noexcept{
+        const std::vector<StatePointer>* states = getStates(token.type);
+        if (states == nullptr || token.position >= states->size()) return nullptr;
+        const ContainerState* state = (*states)[token.position].get();
+        if (state == nullptr && fallbacks_) return getFallbackState(token);
+        return state;
+    };
+
+    const ContainerState* ParseResult::getFallbackState(const Token& token) const noexcept{
+        if (token.type != ArgType::Positional && token.type != ArgType::Option) return nullptr;
+        std::vector<Fallbacks::Slot>& slots = fallbacks_->slots[token.type == ArgType::Positional? 0 : 1];
+        if (token.position >= slots.size()) return nullptr;
+
+        // The state is published once resolved, so later reads do not lock.
+        // A callback reading its own argument gets the state being resolved.
+        Fallbacks::Slot& slot = slots[token.position];
+        if (slot.resolved.load(std::memory_order_acquire)) return slot.state.get();
+        std::lock_guard<std::recursive_mutex> lock(slot.mutex);
+        if (!slot.resolved.load(std::memory_order_relaxed) && !slot.resolving) {
+            slot.resolving = true;
+            schema_.get()->fallback(token, fallbacks_->config.get(), slot.state, slot.buffer);
+            slot.resolved.store(true, std::memory_order_release);
+        }
+        return slot.state.get();
+    };
+
+    ContainerState* ParseResult::getMutableState(const Token& token) noexcept{
+        // Only the states of the command line are modified while parsing.
+        std::vector<StatePointer>* states = getStates(token.type);
+        if (states == nullptr || token.position >= states->size()) return nullptr;
+        return (*states)[token.position].get();
+    };
+
+    ContainerState* ParseResult::activate(const Token& token, const Container* container){
+        StatePointer& state = (*getStates(token.type))[token.position];
+        if (!state) state.reset(container->createState(resource_));
+        return state.get();
+    };
+
+    bool ParseResult::isActive(const Token& token) const noexcept{
+        const ContainerState* state = getState(token);
+        return state != nullptr && state->active;
+    };
+
+    ValueWrapper ParseResult::getValue(const std::string& name) const noexcept{
+        return getValue(schema_.isRegistered(name));
+    };
+
+    ValueWrapper ParseResult::getValue(const Token& token) const noexcept{
+        const ContainerState* state = getState(token);
+        const InputState* input_state = dynamic_cast<const InputState*>(state);
+        if (input_state != nullptr) return input_state->getValue();
+        else return {std::vector<std::string>(), state != nullptr && state->active};
+    };
+
+    Span<std::string_view> ParseResult::getValueView(const std::string& name) const noexcept{
+        return getValueView(schema_.isRegistered(name));
+    };
+
+    Span<std::string_view> ParseResult::getValueView(const Token& token) const noexcept{
+        const InputState* state = dynamic_cast<const InputState*>(getState(token));
+        if (state == nullptr) return Span<std::string_view>();
+        return Span<std::string_view>(state->user_input.data(), state->user_input.size());
+    };
+
+    std::string ParseResult::getProgramName() const noexcept{
+        std::string program_name = schema_.getProgramName();
+        return program_name != ""? program_name : program_name_;
+    };
+
+    const CompiledSchema& ParseResult::getSchema() const noexcept{
+        return schema_;
+    };
+
+    std::pmr::memory_resource* ParseResult::getMemoryResource() const noexcept{
+    #ifdef ARGSPARSER_INSTRUMENTATION
+        // Allocations are counted on their way to the resource of the parse.
+        if (counter_) return counter_->upstream();
+    #endif
+        return resource_;
+    };
+
+    std::vector<const InputState*> ParseResult::getInputStates() const{
+        std::vector<const InputState*> states;
+        for (const std::vector<StatePointer>* registry : {&positional_states_, &option_states_}) {
+            for (size_t i = 0; i < registry->size(); i++) {
+                const InputState* state = static_cast<const InputState*>((*registry)[i].get());
+                if (state != nullptr) states.push_back(state);
+            }
+        }
+        return states;
+    };
+
+    void ParseResult::forceConversions() const{
+        std::vector<const InputState*> states = getInputStates();
+        for (size_t i = 0; i < states.size(); i++) states[i]->forceConversion();
+    };
+
+    void ParseResult::forceConversions(ThreadPool& pool) const{
+        std::vector<const InputState*> states = getInputStates();
+        pool.run(states.size(), [&states](size_t i){ states[i]->forceConversion(); });
+    };
+
+    ParseStatistics ParseResult::getStatistics() const{
+        ParseStatistics statistics;
+    #ifdef ARGSPARSER_INSTRUMENTATION
+        if (statistics_) statistics = *statistics_;
+        if (counter_) {
+            statistics.allocations = counter_->allocations();
+            statistics.allocated_bytes = counter_->bytes();
+        }
+    #endif
+        return statistics;
+    };
+}
\ No newline at end of file
@@ -10,6 +10,38 @@
 
 #include <argsparser/parserImpl.h>
 
+namespace
+{
+    // A set of the strings of a batch of registrations, used to find those
+    // repeated within the batch. It probes a single flat array sized for the
+    // whole batch, so that it allocates once rather than once per string. The
+    // strings are not copied and must outlive the set.
+    class BatchSet{
+        public:
+            explicit BatchSet(size_t count){
+                size_t capacity = 16;
+                while (capacity < count * 2) capacity *= 2;
+                slots_.resize(capacity);
+            }
+
+            // Adds a string to the set, returning false if it was already in it.
+            bool insert(std::string_view key){
+                const size_t mask = slots_.size() - 1;
+                for (size_t i = (size_t)ArgsParser::Detail::hashBytes(key.data(), key.size()) & mask;; i = (i + 1) & mask) {
+                    // Free slots hold a null view, which no string produces.
+                    if (slots_[i].data() == nullptr) {
+                        slots_[i] = key;
+                        return true;
+                    }
+                    if (slots_[i] == key) return false;
+                }
+            }
+
+        private:
+            std::vector<std::string_view> slots_;
+    };
+}
+
 namespace ArgsParser
 {
     Parser::Parser():
@@ -20,8 +52,16 @@ namespace ArgsParser
         error_callback_(ArgsTools::print_error)
         { }
 
-    Parser::Parser(bool no_except, ErrorHandler error_callback):
-        parser_impl(new ParserImpl()),
+    Parser::Parser(std::pmr::memory_resource* resource):
+        parser_impl(new ParserImpl(resource)),
+        error_code(parser_impl->error_code),
+        error_description(parser_impl->error_description),
+        no_except_(true),
+        error_callback_(ArgsTools::print_error)
+        { }
+
+    Parser::Parser(bool no_except, ErrorHandler error_callback, std::pmr::memory_resource* resource):
+        parser_impl(new ParserImpl(resource)),
         error_code(parser_impl->error_code),
         error_description(parser_impl->error_description),
         no_except_(no_except),
@@ -29,16 +69,15 @@ namespace ArgsParser
         { }
 
     Parser::Parser(const Parser& other):
-        parser_impl(new ParserImpl()),
+        parser_impl(new ParserImpl(other.parser_impl->schema)),
         error_code(parser_impl->error_code),
         error_description(parser_impl->error_description),
         no_except_(other.no_except_),
         error_callback_(other.error_callback_)
     { 
-        for(auto var : parser_impl->names)
-        {
-            registerContainer(var.second.type, getContainer(var.second)->clone());
-        }
+        // The schema is shared until either parser modifies it, so only the
+        // state of the last parse is copied.
+        parser_impl->result = other.parser_impl->result;
     }
 
     Parser::Parser(Parser&& other):
@@ -59,25 +98,42 @@ namespace ArgsParser
     }
 
 
-    Parser::ParserImpl::ParserImpl() :
+    Parser::ParserImpl::ParserImpl(std::pmr::memory_resource* resource) :
         error_description(""),
-        error_code(0)
+        error_code(0),
+        schema(std::allocate_shared<SchemaImpl>(
+            std::pmr::polymorphic_allocator<SchemaImpl>(resolve(resource)), resource))
         { };
 
-    Parser::ParserImpl::~ParserImpl(){
-        // Iterates through the registries, deleting containers as they appear.
-        for (size_t i = 0; i < registered_options.size(); i++)
-        {
-            delete registered_options[i];
-            registered_options[i] = nullptr;
-        };
-        for (size_t i = 0; i < registered_positionals.size(); i++)
-        {
-            delete registered_positionals[i];
-            registered_positionals[i] = nullptr;
-        };
+    Parser::ParserImpl::ParserImpl(const std::shared_ptr<SchemaImpl>& schema) :
+        error_description(""),
+        error_code(0),
+        schema(schema)
+        { };
+
+    SchemaImpl& Parser::ParserImpl::mutableSchema(){
+        // Only this parser can create new references to its schema, so if it
+        // and its own result hold the only ones, no other thread can be
+        // reading it. The result of the last parse keeps reading the schema
+        // as it is changed, which is safe, as states are looked up by
+        // position and registering only appends arguments.
+        const long owners = result.getSchema().get() == schema.get()? 2 : 1;
+        if (schema.use_count() > owners) {
+            schema = std::allocate_shared<SchemaImpl>(
+                std::pmr::polymorphic_allocator<SchemaImpl>(schema->resource), *schema);
+        }
+        return *schema;
+    };
+
+    InputContainer* Parser::ParserImpl::mutableInput(const Token& token){
+        if (dynamic_cast<InputContainer*>(schema->getContainer(token)) == nullptr) return nullptr;
+        return static_cast<InputContainer*>(mutableSchema().getContainer(token));
     };
 
+    std::pmr::memory_resource* Parser::getMemoryResource() const noexcept{
+        return parser_impl->schema->resource;
+    }
+
     void swap(Parser& first, Parser& second){
         using std::swap;
 
@@ -85,11 +141,64 @@ namespace ArgsParser
     }
 
     std::string Parser::getProgramName() const noexcept {
-        return parser_impl->program_name;
+        if (parser_impl->schema->program_name != "") return parser_impl->schema->program_name;
+        return parser_impl->result.program_name_;
     }
 
     void Parser::setProgramName(const std::string& name) {
-        parser_impl->program_name = name;
+        parser_impl->mutableSchema().program_name = name;
+    }
+
+    bool Parser::setLazy(const std::string& name, bool lazy) {
+        return setLazy(isRegistered(name), lazy);
+    }
+
+    bool Parser::setLazy(const Token& token, bool lazy) {
+        InputContainer* container = parser_impl->mutableInput(token);
+        if (container == nullptr) return false;
+        container->lazy_ = lazy;
+        return true;
+    }
+
+    bool Parser::setEnvironment(const std::string& name, const std::string& variable) {
+        return setEnvironment(isRegistered(name), variable);
+    }
+
+    bool Parser::setEnvironment(const Token& token, const std::string& variable) {
+        InputContainer* container = parser_impl->mutableInput(token);
+        if (container == nullptr) return false;
+        container->environment_.assign(variable.data(), variable.size());
+        parser_impl->schema->has_fallbacks = true;
+        return true;
+    }
+
+    bool Parser::setConfigKey(const std::string& name, const std::string& key) {
+        return setConfigKey(isRegistered(name), key);
+    }
+
+    bool Parser::setConfigKey(const Token& token, const std::string& key) {
+        InputContainer* container = parser_impl->mutableInput(token);
+        if (container == nullptr) return false;
+        container->config_key_.assign(key.data(), key.size());
+        parser_impl->schema->has_fallbacks = true;
+        return true;
+    }
+
+    bool Parser::setDefault(const std::string& name, const std::string& value) {
+        return setDefault(isRegistered(name), value);
+    }
+
+    bool Parser::setDefault(const Token& token, const std::string& value) {
+        InputContainer* container = parser_impl->mutableInput(token);
+        if (container == nullptr) return false;
+        container->default_value_.assign(value.data(), value.size());
+        container->has_default_ = true;
+        parser_impl->schema->has_fallbacks = true;
+        return true;
+    }
+
+    void Parser::forceConversions() const {
+        parser_impl->result.forceConversions();
     }
 
     Token Parser::isRegistered(const std::string& symbol) const noexcept{
@@ -97,20 +206,37 @@ namespace ArgsParser
     }
 
     Token Parser::isNameRegistered(const std::string& name) const noexcept{
-        return parser_impl->names.count(name) > 0? parser_impl->names[name] : NULL_TOKEN;
+        return parser_impl->schema->findName(name);
     }
 
     Token Parser::isIdentifierRegistered(const std::string& identifier) const noexcept{
-        try {
-            // First check if this is a proper identifier. If not, make one.
-            const std::string identifier_ = 
-                (ArgsTools::check_identifier(identifier)? identifier : ArgsTools::make_identifier(identifier));
+        // Once parsed, the schema holds a lookup table that applies the same
+        // normalization as make_identifier without allocating or throwing.
+        const SchemaImpl& schema = *parser_impl->schema;
+        if (schema.frozen.load(std::memory_order_acquire)) return schema.lookup_table.find(identifier.data(), identifier.size());
+
+        // First check if this is a proper identifier. If not, make one.
+        std::string identifier_;
+        if (!ArgsTools::try_make_identifier(identifier, identifier_).empty()) return NULL_TOKEN;
+
+        return schema.findIdentifier(identifier_);
+    }
 
-            return parser_impl->identifiers.count(identifier_) > 0? parser_impl->identifiers[identifier_] : NULL_TOKEN;
+    Token Parser::matchIdentifier(const std::string& identifier) const noexcept{
+        // Freezing only fails if memory runs out, in which case nothing is
+        // found.
+        try {
+            parser_impl->schema->freeze();
         }
-        catch (const std::exception&) { // Catch exception thrown by make_identifier if the identifier string is invalid.
+        catch (...) {
             return NULL_TOKEN;
         }
+        return parser_impl->schema->matchIdentifier(identifier);
+    }
+
+    std::vector<std::string> Parser::suggestIdentifiers(const std::string& identifier, size_t max_distance, size_t max_results) const{
+        parser_impl->schema->freeze();
+        return parser_impl->schema->identifier_trie.suggest(identifier, max_distance, max_results);
     }
 
     Token Parser::registerSwitch(
@@ -120,18 +246,12 @@ namespace ArgsParser
         const Callback& callback
     ){
         // First check if all identifiers are open to be registered.
-        if(isNameRegistered(name)) 
-            throw std::runtime_error( "Name \"" + name + "\" is already registered." );
+        std::vector<std::string> identifiers_;
+        std::string error = checkRegistration(name, identifiers, identifiers_);
+        if (!error.empty()) throw std::runtime_error(error);
 
-        std::vector<std::string> identifiers_(identifiers.size());
-        for(size_t i = 0; i < identifiers.size(); i++)
-        {
-            identifiers_[i] = ArgsTools::make_identifier(identifiers[i]);
-            if(isIdentifierRegistered(identifiers_[i]))
-                throw std::runtime_error( "Identifier \"" + identifiers_[i] + "\" is already registered." );
-        }
-
-        Container* container = new Container(
+        Container* container = create<Container>(
+            getMemoryResource(),
             ArgType::Switch,
             name,
             identifiers_,
@@ -147,31 +267,32 @@ namespace ArgsParser
     Token Parser::registerContainer(ArgType type, Container* container){
         // The identifier type allows for up to 6553 options of each type to be
         // registered. As such, throw an exception if that amount is reached.
+        SchemaImpl& schema = parser_impl->mutableSchema();
 
         // Register the container
         size_t index;
         switch (type)
         {
         case ArgType::Positional:
-            if (parser_impl->registered_positionals.size() == (std::numeric_limits<unsigned short>::max()))
+            if (schema.registered_positionals.size() == (std::numeric_limits<unsigned short>::max()))
                 throw new std::runtime_error("Exceeded maximum number of same type options (>" 
                     + std::to_string(std::numeric_limits<unsigned short>::max()) + std::string(")."));
-            index = parser_impl->registered_positionals.size();
-            parser_impl->registered_positionals.push_back(container);
+            index = schema.registered_positionals.size();
+            schema.registered_positionals.push_back(container);
             break;
         case ArgType::Option:
-            if (parser_impl->registered_options.size() == (std::numeric_limits<unsigned short>::max()))
+            if (schema.registered_options.size() == (std::numeric_limits<unsigned short>::max()))
                 throw new std::runtime_error("Exceeded maximum number of same type options (>" 
                     + std::to_string(std::numeric_limits<unsigned short>::max()) + std::string(")."));
-            index = parser_impl->registered_options.size();
-            parser_impl->registered_options.push_back(container);
+            index = schema.registered_options.size();
+            schema.registered_options.push_back(container);
             break;
         case ArgType::Switch:
-            if (parser_impl->registered_switches.size() == (std::numeric_limits<unsigned short>::max()))
+            if (schema.registered_switches.size() == (std::numeric_limits<unsigned short>::max()))
                 throw new std::runtime_error("Exceeded maximum number of same type options (>" 
                     + std::to_string(std::numeric_limits<unsigned short>::max()) + std::string(")."));
-            index = parser_impl->registered_switches.size();
-            parser_impl->registered_switches.push_back(container);
+            index = schema.registered_switches.size();
+            schema.registered_switches.push_back(container);
             break;
         default:
             return NULL_TOKEN;
@@ -181,11 +302,9 @@ namespace ArgsParser
         Token id_token =  {type, (unsigned short)index};
 
         // Add the id to the map of names.
-        parser_impl->names[container->getName()] = id_token;
-        std::vector<std::string> identifiers = container->getIdentifiers();
-        for( size_t i = 0; i < identifiers.size(); i++){
-            parser_impl->identifiers[identifiers[i]] = id_token;
-        }
+        schema.frozen.store(false, std::memory_order_relaxed);
+        schema.help_text.reset();
+        schema.index(id_token, container);
 
         return id_token;
     }
@@ -194,9 +313,149 @@ namespace ArgsParser
         parser_impl->error_description = error_string;
     }
 
+    std::string Parser::checkRegistration(
+        const std::string& name,
+        const std::vector<std::string>& identifiers,
+        std::vector<std::string>& normalized
+    ) const{
+        if(isNameRegistered(name))
+            return "Name \"" + name + "\" is already registered.";
+
+        normalized.resize(identifiers.size());
+        for(size_t i = 0; i < identifiers.size(); i++)
+        {
+            std::string error = ArgsTools::try_make_identifier(identifiers[i], normalized[i]);
+            if(!error.empty()) return error;
+            if(isIdentifierRegistered(normalized[i]))
+                return "Identifier \"" + normalized[i] + "\" is already registered.";
+        }
+        return std::string();
+    }
+
+    Token Parser::registrationError(const std::string& message){
+        std::string error_string = "Registration Error: " + message;
+
+        if(!no_except_) throw std::runtime_error(error_string);
+        else setError(error_string);
+
+        return NULL_TOKEN;
+    }
+
+    std::vector<Token> Parser::registerMany(const std::vector<ArgumentSpec>& specs){
+        // The batch is checked against the schema without modifying it, so
+        // that a rejected batch does not copy a schema shared with another
+        // parser.
+        const SchemaImpl& schema = *parser_impl->schema;
+        std::pmr::memory_resource* resource = getMemoryResource();
+
+        // The names and normalized identifiers of the batch, so that conflicts
+        // within the batch are found along with those against the parser. The
+        // identifiers are normalized straight into the memory resource of the
+        // parser and moved into the containers.
+        size_t identifier_count = 0;
+        for (size_t i = 0; i < specs.size(); i++) identifier_count += specs[i].identifiers.size();
+        BatchSet names(specs.size());
+        BatchSet identifiers(identifier_count);
+
+        std::vector<std::pmr::vector<std::pmr::string>> normalized;
+        normalized.reserve(specs.size());
+        size_t added[4] = {0, 0, 0, 0};
+        std::string identifier;
+        std::string errors;
+        auto report = [&errors](const std::string& message){
+            if (!errors.empty()) errors += "; ";
+            errors += message;
+        };
+
+        for (size_t i = 0; i < specs.size(); i++) {
+            const ArgumentSpec& spec = specs[i];
+            normalized.emplace_back(resource);
+            if (spec.type != ArgType::Positional && spec.type != ArgType::Switch && spec.type != ArgType::Option) {
+                report("Argument \"" + spec.name + "\" has no type.");
+                continue;
+            }
+            added[spec.type]++;
+
+            if (schema.findName(spec.name) || !names.insert(spec.name))
+                report("Name \"" + spec.name + "\" is already registered.");
+
+            // Positionals are never given identifiers.
+            if (spec.type == ArgType::Positional) continue;
+
+            // Reserved up front, as the set keeps views of the identifiers.
+            normalized[i].reserve(spec.identifiers.size());
+            for (size_t j = 0; j < spec.identifiers.size(); j++) {
+                std::string error = ArgsTools::try_make_identifier(spec.identifiers[j], identifier);
+                if (!error.empty()) {
+                    report(error);
+                    continue;
+                }
+                normalized[i].emplace_back(identifier.data(), identifier.size());
+                if (schema.findIdentifier(identifier) || !identifiers.insert(normalized[i].back()))
+                    report("Identifier \"" + identifier + "\" is already registered.");
+            }
+        }
+
+        const std::pmr::vector<Container*>* registries[4] = {
+            nullptr, &schema.registered_positionals, &schema.registered_switches, &schema.registered_options
+        };
+        for (size_t type = ArgType::Positional; type <= ArgType::Option; type++) {
+            if (registries[type]->size() + added[type] > std::numeric_limits<unsigned short>::max())
+                report("Exceeded maximum number of same type options (>"
+                    + std::to_string(std::numeric_limits<unsigned short>::max()) + std::string(")."));
+        }
+
+        if (!errors.empty()) {
+            registrationError(errors);
+            return std::vector<Token>();
+        }
+
+        // Grow every table once, so that registering the batch never rehashes.
+        SchemaImpl& target = parser_impl->mutableSchema();
+        target.names.reserve(target.names.size() + specs.size());
+        target.identifiers.reserve(target.identifiers.size() + identifier_count);
+        target.registered_positionals.reserve(target.registered_positionals.size() + added[ArgType::Positional]);
+        target.registered_switches.reserve(target.registered_switches.size() + added[ArgType::Switch]);
+        target.registered_options.reserve(target.registered_options.size() + added[ArgType::Option]);
+
+        std::vector<Token> tokens;
+        tokens.reserve(specs.size());
+        for (size_t i = 0; i < specs.size(); i++) {
+            const ArgumentSpec& spec = specs[i];
+            Container* container;
+            if (spec.type == ArgType::Switch) {
+                container = create<Container>(
+                    resource,
+                    ArgType::Switch,
+                    spec.name,
+                    std::move(normalized[i]),
+                    spec.description,
+                    spec.callback
+                );
+            }
+            else {
+                bool positional = spec.type == ArgType::Positional;
+                container = create<InputContainer>(
+                    resource,
+                    spec.type,
+                    spec.name,
+                    std::move(normalized[i]),
+                    positional? "" : spec.description,
+                    spec.placeholder_text,
+                    positional? 1 : spec.max_values,
+                    spec.validator,
+                    spec.error_callback,
+                    spec.callback
+                );
+            }
+            tokens.push_back(registerContainer(spec.type, container));
+        }
+        return tokens;
+    }
+
     std::vector<Token> Parser::getRegisteredTokens() const{
         std::vector<Token> tokens;
-        for(auto var : parser_impl->names)
+        for(auto var : parser_impl->schema->names)
         {
             tokens.push_back(var.second);
         }
@@ -205,9 +464,9 @@ namespace ArgsParser
 
     std::vector<std::string> Parser::getRegisteredNames() const{
         std::vector<std::string> names;
-        for(auto var : parser_impl->names)
+        for(auto var : parser_impl->schema->names)
         {
-            names.push_back(var.first);
+            names.push_back(std::string(var.first));
         }
         return names;
     }
@@ -217,75 +476,40 @@ namespace ArgsParser
     }
 
     const Container* Parser::getContainer(const Token& token) const noexcept{
+        return parser_impl->schema->getContainer(token);
+    }
 
-        return const_cast<Container*>(parser_impl->getContainer(token));
+    void Parser::parse(int argc, char* argv[], const ParseOptions& options){
+        // The result is stored before parsing so that callbacks may read the
+        // values parsed so far through the parser.
+        parser_impl->schema->freeze();
+        parser_impl->result = ParseResult(
+            CompiledSchema(parser_impl->schema),
+            options.resource != nullptr? options.resource : parser_impl->schema->resource);
+        parser_impl->schema->parse(argc, argv, parser_impl->result, options);
+    };
 
-    }
+    void Parser::parseStream(int fd, char delimiter, const ParseOptions& options){
+        parser_impl->schema->freeze();
+        parser_impl->result = ParseResult(
+            CompiledSchema(parser_impl->schema),
+            options.resource != nullptr? options.resource : parser_impl->schema->resource);
+        parser_impl->schema->parseStream(fd, delimiter, parser_impl->result, options);
+    };
 
-    void Parser::parse(int argc, char* argv[]){
-        std::string program_name = std::string(argv[0]);
-        program_name = program_name.substr(program_name.find_last_of("/\\")+1);
-        if (getProgramName() == "") setProgramName(program_name);
+    ParseStatistics Parser::getStatistics() const{
+        return parser_impl->result.getStatistics();
+    };
 
-        std::vector<Container*> activeContainers;
-        InputContainer* currentContainer = nullptr;
-        size_t positional = 0;
-        for (int i = 1; i < argc; i++)
-        {
-            std::string current = std::string(argv[i]);
-            // First check whether we are dealing with an option or value.
-            if(current.size() > 1) {
-                if(current.at(0) == '-') // This is an option
-                {
-                    // Load the container for the option and set it to active.
-                    Container* baseContainer = parser_impl->getContainer(isIdentifierRegistered(current));
-                    if(baseContainer) {
-                        baseContainer->setActive();
-                        activeContainers.push_back(baseContainer);
-                        // If container is not a switch, cast it to an input container and keep it loaded.
-                        if(baseContainer->getType() != ArgType::Switch) 
-                            currentContainer = dynamic_cast<InputContainer*>(baseContainer);
-                    }
-                }
-                else // This is a value
-                {
-                    // If there is no current container, this is a positional, so load the container.
-                    if(currentContainer == nullptr && (size_t)positional < parser_impl->registered_positionals.size()) {
-                        currentContainer = dynamic_cast<InputContainer*>(
-                            parser_impl->getContainer({ArgType::Positional, (unsigned short)positional}));
-                            activeContainers.push_back(currentContainer);
-                    }
-                    
-                    // If a container is loaded
-                    if(currentContainer != nullptr)
-                    {
-                        // If this is a value option and the maximum amount of options have been loaded, throw an exception.
-                        if(currentContainer->getType() == ArgType::Option && 
-                        currentContainer->getInputSize() == currentContainer->getMaxInputs())
-                            throw std::runtime_error("Too many arguments to option " + currentContainer->getName());
-
-                        // Append the current input to the container.
-                        currentContainer->setActive(current);
-
-                        // If the current container is a positional argument, increment the positional counter and unload it.
-                        if(currentContainer->getType() == ArgType::Positional)
-                        {
-                            positional++;
-                            currentContainer = nullptr;
-                        }
-                        // Otherwise, it is an option, so unload it if it has read the maximum amount of inputs
-                        else
-                        {
-                            if(currentContainer->getInputSize() == currentContainer->getMaxInputs()) 
-                                currentContainer = nullptr;
-                        }
-                    }
-                }
-            }
-        }
-        for (size_t i = 0; i < activeContainers.size(); i++) {
-            activeContainers[i]->postProcess();
-        };
+    const ParseResult& Parser::getResult() const noexcept{
+        return parser_impl->result;
+    };
+
+    CompiledSchema Parser::compile() const{
+        // The schema is shared rather than copied. The parser copies it
+        // before registering anything else.
+        parser_impl->schema->freeze();
+        return CompiledSchema(parser_impl->schema);
     };
 
     ValueWrapper Parser::getValue(const std::string& name) const noexcept{
@@ -293,9 +517,15 @@ namespace ArgsParser
     };
 
     ValueWrapper Parser::getValue(const Token& token) const noexcept{
-        const InputContainer* container = dynamic_cast<const InputContainer*>(getContainer(token));
-        if (container != nullptr) return container->getValue();
-        else return {std::vector<std::string>(), container->isActive()};
+        return parser_impl->result.getValue(token);
+    };
+
+    Span<std::string_view> Parser::getValueView(const std::string& name) const noexcept{
+        return getValueView(isRegistered(name));
+    };
+
+    Span<std::string_view> Parser::getValueView(const Token& token) const noexcept{
+        return parser_impl->result.getValueView(token);
     };
 
     Token Parser::registerPositional(
@@ -305,35 +535,27 @@ namespace ArgsParser
         const Validator<std::string>& validator,
         const ErrorHandler& error_callback
     ){
-        try{
-            // First check if name is already registered.
-            if(isNameRegistered(name))
-                throw std::runtime_error("Name \"" + name + "\" is already registered.");
-
-            InputContainer* container = new InputContainer(
-                ArgType::Positional,
-                name,
-                std::vector<std::string>(),
-                "",
-                placeholder_text,
-                1,
-                validator,
-                error_callback,
-                callback
-            );
-
-            Token id = registerContainer(ArgType::Positional, container);
-
-            return id;
-        }
-        catch (const std::exception& e){
-            std::string error_string = std::string("Registration Error: ") + e.what();
+        // First check if name is already registered.
+        std::vector<std::string> identifiers_;
+        std::string error = checkRegistration(name, std::vector<std::string>(), identifiers_);
+        if (!error.empty()) return registrationError(error);
+
+        InputContainer* container = create<InputContainer>(
+            getMemoryResource(),
+            ArgType::Positional,
+            name,
+            identifiers_,
+            "",
+            placeholder_text,
+            1,
+            validator,
+            error_callback,
+            callback
+        );
 
-            if(!no_except_) throw std::runtime_error(error_string);
-            else setError(error_string);
+        Token id = registerContainer(ArgType::Positional, container);
 
-            return NULL_TOKEN;
-        }
+        return id;
     };
 
     Token Parser::registerOption(
@@ -346,70 +568,28 @@ namespace ArgsParser
         const Validator<std::string>& validator,
         const ErrorHandler& error_callback
     ){
-        try{
-            // First check if all identifiers are open to be registered.
-            if(isNameRegistered(name)) 
-                throw std::runtime_error( "Name \"" + name + "\" is already registered." );
-
-            std::vector<std::string> identifiers_(identifiers.size());
-            for(size_t i = 0; i < identifiers.size(); i++)
-            {
-                identifiers_[i] = ArgsTools::make_identifier(identifiers[i]);
-                if(isIdentifierRegistered(identifiers_[i]))
-                    throw std::runtime_error( "Identifier \"" + identifiers_[i] + "\" is already registered." );
-            }
-        
-            // If check was successful, create a new container object.
-            InputContainer* container = new InputContainer(
-                ArgType::Option,
-                name,
-                identifiers_,
-                description,
-                placeholder_text,
-                max_values,
-                validator,
-                error_callback,
-                callback
-            );
-
-            // And push the container to the array of registered options.
-            Token id = registerContainer(ArgType::Option, container);
-
-            return id;
-        }
-        catch (const std::exception& e) {
-            std::string error_string = std::string("Registration Error: ") + e.what();
+        // First check if all identifiers are open to be registered.
+        std::vector<std::string> identifiers_;
+        std::string error = checkRegistration(name, identifiers, identifiers_);
+        if (!error.empty()) return registrationError(error);
+
+        // If check was successful, create a new container object.
+        InputContainer* container = create<InputContainer>(
+            getMemoryResource(),
+            ArgType::Option,
+            name,
+            identifiers_,
+            description,
+            placeholder_text,
+            max_values,
+            validator,
+            error_callback,
+            callback
+        );
 
-            if(!no_except_) throw std::runtime_error(error_string);
-            else setError(error_string);
+        // And push the container to the array of registered options.
+        Token id = registerContainer(ArgType::Option, container);
 
-            return NULL_TOKEN;
-        }
-    };
-
-    Container* Parser::ParserImpl::getContainer(const Token& token) {
-        try
-        {
-            switch (token.type)
-            {
-                case ArgType::Option:
-                    return registered_options.at(token.position);
-                    break;
-                case ArgType::Positional:
-                    return registered_positionals.at(token.position);
-                    break;
-                case ArgType::Switch:
-                    return registered_switches.at(token.position);
-                    break;
-                default:
-                    throw std::runtime_error("Container not found (NULL_TOKEN).");
-                    break;
-            }      
-        }
-        catch (const std::exception& e)
-        {
-            error_description = e.what();
-            return nullptr;
-        }
+        return id;
     };
 }
@@ -0,0 +1,767 @@
+/**
+ * schema.cpp
+ * 
+ * This file contains the implementation of the CompiledSchema class and of the
+ * schema internals shared with the Parser class, including the command line
+ * parsing logic.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <argsparser/mapped_file.h>
+#include <argsparser/schemaImpl.h>
+#include <argsparser/thread_pool.h>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    // The number of response files that may be nested within each other.
+    const unsigned MAX_RESPONSE_FILE_DEPTH = 16;
+
+    // The size of the blocks a stream of arguments is read into.
+    const size_t STREAM_BLOCK_SIZE = 64 * 1024;
+
+    // Allocates a buffer from a memory resource, which is returned to it once
+    // every copy of the pointer has been released.
+    std::shared_ptr<char> make_buffer(std::pmr::memory_resource* resource, size_t size){
+        char* buffer = static_cast<char*>(resource->allocate(size, 1));
+        try {
+            return std::shared_ptr<char>(
+                buffer,
+                [resource, size](char* data){ resource->deallocate(data, size, 1); },
+                std::pmr::polymorphic_allocator<char>(resource)
+            );
+        }
+        catch (...) {
+            resource->deallocate(buffer, size, 1);
+            throw;
+        }
+    }
+
+    // Reads up to size bytes from a file descriptor, retrying if interrupted.
+    size_t read_some(int fd, char* data, size_t size){
+        for (;;) {
+        #ifdef _WIN32
+            int count = _read(fd, data, (unsigned int)std::min<size_t>(size, 1 << 30));
+        #else
+            ssize_t count = read(fd, data, size);
+        #endif
+            if (count >= 0) return (size_t)count;
+            if (errno != EINTR) throw std::runtime_error(std::string("Unable to read arguments: ") + std::strerror(errno));
+        }
+    }
+
+    // Whether a character separates arguments in a response file. Unlike
+    // std::isspace, this does not depend on the locale.
+    inline bool is_separator(char character){
+        return character == ' ' || (character >= '\t' && character <= '\r');
+    }
+
+    // Splits the contents of a response file into arguments in place, passing
+    // each one to consume as it is found. Arguments are separated by
+    // whitespace. Single or double quotes keep whitespace within an argument,
+    // and a backslash includes the next character as is. Quotes and escapes
+    // are removed by shifting the rest of the argument back, so the buffer is
+    // only written to after one is found.
+    template <typename F>
+    void tokenize(char* data, size_t size, F consume){
+        char* end = data + size;
+        char* read = data;
+        while (read < end) {
+            while (read < end && is_separator(*read)) read++;
+            if (read == end) break;
+
+            char* start = read;
+            char* write = read;
+            char quote = '\0';
+            for (; read < end; read++) {
+                char current = *read;
+                if (current == '\\' && read + 1 < end) {
+                    current = *++read;
+                }
+                else if (quote != '\0') {
+                    if (current == quote) {
+                        quote = '\0';
+                        continue;
+                    }
+                }
+                else if (current == '\'' || current == '"') {
+                    quote = current;
+                    continue;
+                }
+                else if (is_separator(current)) {
+                    break;
+                }
+                if (write != read) *write = current;
+                write++;
+            }
+            consume(std::string_view(start, (size_t)(write - start)));
+        }
+    }
+}
+
+namespace ArgsParser
+{
+    SchemaImpl::SchemaImpl(std::pmr::memory_resource* resource) :
+        resource(resolve(resource)),
+        program_name(""),
+        names(this->resource),
+        identifiers(this->resource),
+        registered_positionals(this->resource),
+        registered_switches(this->resource),
+        registered_options(this->resource),
+        lookup_table(this->resource),
+        identifier_trie(this->resource),
+        frozen(false),
+        help_width(0),
+        has_fallbacks(false),
+        has_async_validators(false)
+        { };
+
+    SchemaImpl::SchemaImpl(const SchemaImpl& other) :
+        resource(other.resource),
+        program_name(other.program_name),
+        names(resource),
+        identifiers(resource),
+        registered_positionals(resource),
+        registered_switches(resource),
+        registered_options(resource),
+        lookup_table(resource),
+        identifier_trie(resource),
+        frozen(false),
+        help_width(0),
+        has_fallbacks(other.has_fallbacks),
+        has_async_validators(other.has_async_validators)
+    {
+        // Another holder of the schema being copied may be freezing it.
+        {
+            std::lock_guard<std::mutex> lock(other.freeze_mutex);
+            if (other.frozen.load(std::memory_order_relaxed)) {
+                lookup_table = IdentifierTable(other.lookup_table, resource);
+                identifier_trie = IdentifierTrie(other.identifier_trie, resource);
+                frozen.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        // The maps refer to strings owned by the containers, so they are
+        // rebuilt from the clones rather than copied.
+        names.reserve(other.names.size());
+        identifiers.reserve(other.identifiers.size());
+
+        registered_positionals.reserve(other.registered_positionals.size());
+        for (size_t i = 0; i < other.registered_positionals.size(); i++) {
+            registered_positionals.push_back(other.registered_positionals[i]->clone(resource));
+            index({ArgType::Positional, (unsigned short)i}, registered_positionals[i]);
+        }
+
+        registered_switches.reserve(other.registered_switches.size());
+        for (size_t i = 0; i < other.registered_switches.size(); i++) {
+            registered_switches.push_back(other.registered_switches[i]->clone(resource));
+            index({ArgType::Switch, (unsigned short)i}, registered_switches[i]);
+        }
+
+        registered_options.reserve(other.registered_options.size());
+        for (size_t i = 0; i < other.registered_options.size(); i++) {
+            registered_options.push_back(other.registered_options[i]->clone(resource));
+            index({ArgType::Option, (unsigned short)i}, registered_options[i]);
+        }
+    };
+
+    SchemaImpl::~SchemaImpl(){
+        // Iterates through the registries, destroying containers as they appear.
+        for (size_t i = 0; i < registered_options.size(); i++)
+        {
+            registered_options[i]->destroy();
+            registered_options[i] = nullptr;
+        };
+        for (size_t i = 0; i < registered_switches.size(); i++)
+        {
+            registered_switches[i]->destroy();
+            registered_switches[i] = nullptr;
+        };
+        for (size_t i = 0; i < registered_positionals.size(); i++)
+        {
+            registered_positionals[i]->destroy();
+            registered_positionals[i] = nullptr;
+        };
+    };
+
+    void SchemaImpl::index(const Token& token, const Container* container){
+        names[container->name_] = token;
+        has_async_validators = has_async_validators || container->hasAsyncValidator();
+        for (size_t i = 0; i < container->identifiers_.size(); i++)
+            identifiers[container->identifiers_[i]] = token;
+    };
+
+    Container* SchemaImpl::getContainer(const Token& token) const noexcept{
+        const std::pmr::vector<Container*>* registry;
+        switch (token.type)
+        {
+            case ArgType::Option:
+                registry = &registered_options;
+                break;
+            case ArgType::Positional:
+                registry = &registered_positionals;
+                break;
+            case ArgType::Switch:
+                registry = &registered_switches;
+                break;
+            default:
+                return nullptr;
+        }
+        return token.position < registry->size()? (*registry)[token.position] : nullptr;
+    };
+
+    Token SchemaImpl::findName(std::string_view name) const noexcept{
+        std::pmr::unordered_map<std::string_view, Token>::const_iterator it = names.find(name);
+        return it != names.end()? it->second : NULL_TOKEN;
+    };
+
+    Token SchemaImpl::findIdentifier(std::string_view identifier) const noexcept{
+        std::pmr::unordered_map<std::string_view, Token>::const_iterator it = identifiers.find(identifier);
+        return it != identifiers.end()? it->second : NULL_TOKEN;
+    };
+
+    void SchemaImpl::freeze() const{
+        if (frozen.load(std::memory_order_acquire)) return;
+
+        std::lock_guard<std::mutex> lock(freeze_mutex);
+        if (frozen.load(std::memory_order_relaxed)) return;
+        std::vector<std::pair<std::string_view, Token>> entries(identifiers.begin(), identifiers.end());
+        lookup_table.build(entries);
+        identifier_trie.build(entries);
+        frozen.store(true, std::memory_order_release);
+    };
+
+    Token SchemaImpl::matchIdentifier(std::string_view identifier) const noexcept{
+        Token token = lookup_table.find(identifier.data(), identifier.size());
+        return token? token : identifier_trie.matchPrefix(identifier.data(), identifier.size());
+    };
+
+    std::string SchemaImpl::unknownIdentifierError(std::string_view identifier) const{
+        std::string error = "Unknown argument \"" + std::string(identifier) + "\".";
+        std::vector<std::string> suggestions = identifier_trie.suggest(identifier, 2, 3);
+        for (size_t i = 0; i < suggestions.size(); i++) {
+            error += i == 0? " Did you mean \"" : i + 1 == suggestions.size()? " or \"" : ", \"";
+            error += suggestions[i] + "\"";
+        }
+        if (!suggestions.empty()) error += "?";
+        return error;
+    };
+
+    void SchemaImpl::parse(int argc, char* argv[], ParseResult& result, const ParseOptions& options) const{
+        if (argc > 0) {
+            std::string program_name = std::string(argv[0]);
+            result.program_name_ = program_name.substr(program_name.find_last_of("/\\")+1);
+        }
+
+        // Unless parsing in zero copy mode, copy argv into a single buffer
+        // owned by the result, to which user input will refer.
+        char* buffer = nullptr;
+        if (!options.zero_copy && argc > 1) {
+            size_t buffer_size = 0;
+            for (int i = 1; i < argc; i++) buffer_size += std::strlen(argv[i]) + 1;
+            std::shared_ptr<char> copy = make_buffer(result.resource_, buffer_size);
+            buffer = copy.get();
+            result.buffers_.push_back(copy);
+        }
+
+        Cursor cursor(result, options);
+        {
+            ARGSPARSER_TIME_PHASE(result, scan_ns);
+            for (int i = 1; i < argc; i++)
+            {
+                std::string_view current(argv[i]);
+                if (buffer != nullptr) {
+                    std::memcpy(buffer, current.data(), current.size() + 1);
+                    current = std::string_view(buffer, current.size());
+                    buffer += current.size() + 1;
+                }
+                consume(cursor, current);
+            }
+        }
+        finish(cursor);
+    };
+
+    void SchemaImpl::parseStream(int fd, char delimiter, ParseResult& result, const ParseOptions& options) const{
+        Cursor cursor(result, options);
+
+        // Arguments are read into a block, and parsed as soon as their
+        // delimiter is read. The bytes in [begin, end) are the start of an
+        // argument still being read.
+        size_t capacity = STREAM_BLOCK_SIZE;
+        std::shared_ptr<char> block = make_buffer(result.resource_, capacity);
+        size_t begin = 0;
+        size_t end = 0;
+
+        auto consume_argument = [this, &cursor, delimiter](const char* first, const char* last){
+            if (delimiter == '\n' && last != first && *(last - 1) == '\r') last--;
+            consume(cursor, std::string_view(first, (size_t)(last - first)));
+        };
+
+        {
+            ARGSPARSER_TIME_PHASE(result, scan_ns);
+            for (;;) {
+                size_t count = read_some(fd, block.get() + end, capacity - end);
+                if (count == 0) break;
+
+                // Parse every argument completed by the bytes just read.
+                char* position = block.get() + begin;
+                char* limit = block.get() + end + count;
+                char* next = (char*)std::memchr(block.get() + end, delimiter, count);
+                for (; next != nullptr; next = (char*)std::memchr(position, delimiter, (size_t)(limit - position))) {
+                    consume_argument(position, next);
+                    position = next + 1;
+                }
+                begin = (size_t)(position - block.get());
+                end = (size_t)(limit - block.get());
+                if (end < capacity) continue;
+
+                // The block is full. If a value stored in the result refers to it,
+                // it is handed over to the result and a new block is used. An
+                // argument too long to fit in half a block doubles its size.
+                size_t pending = end - begin;
+                size_t new_capacity = pending * 2 > capacity? capacity * 2 : capacity;
+                if (cursor.retained || new_capacity != capacity) {
+                    std::shared_ptr<char> new_block = make_buffer(result.resource_, new_capacity);
+                    std::memcpy(new_block.get(), block.get() + begin, pending);
+                    if (cursor.retained) result.buffers_.push_back(block);
+                    block = new_block;
+                    capacity = new_capacity;
+                    cursor.retained = false;
+                }
+                else {
+                    std::memmove(block.get(), block.get() + begin, pending);
+                }
+                begin = 0;
+                end = pending;
+            }
+
+            // The last argument may not be followed by a delimiter.
+            if (end > begin) consume_argument(block.get() + begin, block.get() + end);
+        }
+        if (cursor.retained) result.buffers_.push_back(block);
+        finish(cursor);
+    };
+
+    SchemaImpl::Cursor::Cursor(ParseResult& result, const ParseOptions& options) :
+        result(result),
+        options(options),
+        container(nullptr),
+        state(nullptr),
+        token(NULL_TOKEN),
+        positional(0),
+        depth(0),
+        retained(false)
+        { };
+
+    void SchemaImpl::consume(Cursor& cursor, std::string_view current) const{
+        ARGSPARSER_COUNT(cursor.result, tokens);
+
+        // First check whether we are dealing with an option or value.
+        if(current.size() > 1) {
+            if(current[0] == '@' && cursor.options.expand_response_files) // This is a response file
+            {
+                expand(cursor, current.substr(1));
+            }
+            else if(current[0] == '-') // This is an option
+            {
+                // An identifier registered as is takes precedence over the
+                // arguments it could be split into.
+                Token token = lookup(cursor, current.data(), current.size());
+                if(token)
+                    select(cursor, token);
+                else if(!split(cursor, current) && cursor.options.reject_unknown)
+                    throw std::runtime_error(unknownIdentifierError(current));
+            }
+            else // This is a value
+            {
+                // If there is no current container, this is a positional, so load the container.
+                if(cursor.container == nullptr && cursor.positional < registered_positionals.size()) {
+                    Token token = {ArgType::Positional, (unsigned short)cursor.positional};
+                    cursor.container = static_cast<const InputContainer*>(registered_positionals[cursor.positional]);
+                    cursor.state = static_cast<InputState*>(cursor.result.activate(token, cursor.container));
+                    cursor.token = token;
+                    cursor.active.push_back(std::make_pair(cursor.container, cursor.state));
+                }
+                append(cursor, current);
+            }
+        }
+    };
+
+    Token SchemaImpl::lookup(Cursor& cursor, const char* identifier, size_t length) const{
+        ARGSPARSER_TIME_PHASE(cursor.result, lookup_ns);
+        // Only long identifiers are abbreviated, so that bundled short
+        // switches such as -ve are split rather than read as --verbose.
+        Token token = lookup_table.find(identifier, length);
+        if(!token && cursor.options.allow_abbreviations && length > 2 && identifier[0] == '-' && identifier[1] == '-')
+            token = identifier_trie.matchPrefix(identifier, length);
+        if(token) ARGSPARSER_COUNT(cursor.result, lookup_hits);
+        else ARGSPARSER_COUNT(cursor.result, lookup_misses);
+        return token;
+    };
+
+    bool SchemaImpl::split(Cursor& cursor, std::string_view current) const{
+        // A long option followed by its value, as in --level=3.
+        if(current[1] == '-') {
+            size_t separator = current.find('=', 2);
+            if(separator == std::string_view::npos) return false;
+            Token token = lookup(cursor, current.data(), separator);
+            const Container* container = getContainer(token);
+            if(container == nullptr) return false;
+            if(container->getType() == ArgType::Switch)
+                throw std::runtime_error("Switch " + container->getName() + " does not take a value.");
+            select(cursor, token);
+            append(cursor, current.substr(separator + 1));
+            return true;
+        }
+
+        // Short switches bundled together, as in -abc, the last of which may
+        // be an option followed by its value, as in -j8 or -vj8. Each
+        // character is looked up in place.
+        for(size_t i = 1; i < current.size(); i++) {
+            Token token = current[i] == '-'? NULL_TOKEN : lookup(cursor, current.data() + i, 1);
+            const Container* container = getContainer(token);
+            if(container == nullptr) {
+                // Switches before the unknown character have already been
+                // set, just as unknown arguments are otherwise skipped.
+                if(i > 1 && cursor.options.reject_unknown)
+                    throw std::runtime_error("Unknown argument \"-" + std::string(1, current[i]) + "\" in \"" + std::string(current) + "\".");
+                return i > 1;
+            }
+            select(cursor, token);
+            if(container->getType() != ArgType::Switch) {
+                if(i + 1 < current.size()) append(cursor, current.substr(i + 1));
+                return true;
+            }
+        }
+        return true;
+    };
+
+    void SchemaImpl::select(Cursor& cursor, Token token) const{
+        // Load the container for the option and set it to active.
+        const Container* baseContainer = getContainer(token);
+        if(baseContainer) {
+            ContainerState* baseState = cursor.result.getMutableState(token);
+            if(baseState == nullptr) {
+                baseState = cursor.result.activate(token, baseContainer);
+                cursor.active.push_back(std::make_pair(baseContainer, baseState));
+            }
+            baseContainer->setActive(*baseState);
+            // If container is not a switch, cast it to an input container and keep it loaded.
+            if(baseContainer->getType() != ArgType::Switch) {
+                cursor.container = static_cast<const InputContainer*>(baseContainer);
+                cursor.state = static_cast<InputState*>(baseState);
+                cursor.token = token;
+            }
+        }
+    };
+
+    void SchemaImpl::append(Cursor& cursor, std::string_view value) const{
+        // If a container is loaded
+        if(cursor.container != nullptr)
+        {
+            // If this is a value option and the maximum amount of options have been loaded, throw an exception.
+            if(cursor.container->getType() == ArgType::Option &&
+            cursor.state->user_input.size() == cursor.container->getMaxInputs())
+                throw std::runtime_error("Too many arguments to option " + cursor.container->getName());
+
+            // Append the current input to the container, unless the value sink consumes it.
+            if(cursor.options.value_sink != nullptr && cursor.options.value_sink(cursor.token, value)) {
+                cursor.state->active = true;
+            }
+            else {
+                cursor.container->setActive(*cursor.state, value);
+                cursor.retained = true;
+            }
+
+            // If the current container is a positional argument, increment the positional counter and unload it.
+            if(cursor.container->getType() == ArgType::Positional)
+            {
+                cursor.positional++;
+                cursor.container = nullptr;
+            }
+            // Otherwise, it is an option, so unload it if it has read the maximum amount of inputs
+            else
+            {
+                if(cursor.state->user_input.size() == cursor.container->getMaxInputs())
+                    cursor.container = nullptr;
+            }
+        }
+    };
+
+    void SchemaImpl::expand(Cursor& cursor, std::string_view path) const{
+        // Response files may refer to other response files, but a file that
+        // refers to itself would never end.
+        if (cursor.depth == MAX_RESPONSE_FILE_DEPTH)
+            throw std::runtime_error("Response files nested too deeply at \"" + std::string(path) + "\".");
+
+        std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(std::string(path));
+        cursor.result.buffers_.push_back(std::shared_ptr<const char>(file, file->data()));
+
+        cursor.depth++;
+        tokenize(file->data(), file->size(), [this, &cursor](std::string_view token){
+            consume(cursor, token);
+        });
+        cursor.depth--;
+    };
+
+    void SchemaImpl::finish(Cursor& cursor) const{
+    #ifdef ARGSPARSER_INSTRUMENTATION
+        // Time spent in the functions of each argument is added to its own
+        // statistics, which must not move while it is post-processed.
+        ARGSPARSER_TIME_PHASE(cursor.result, post_process_ns);
+        std::vector<ArgumentStatistics>& arguments = cursor.result.statistics_->arguments;
+        const size_t first_argument = arguments.size();
+        arguments.reserve(arguments.size() + cursor.active.size());
+        for (size_t i = 0; i < cursor.active.size(); i++) {
+            arguments.push_back(ArgumentStatistics());
+            arguments.back().name = cursor.active[i].first->getName();
+        }
+    #endif
+
+        if (cursor.options.pool != nullptr || has_async_validators) {
+            postProcess(cursor, cursor.options.pool);
+        }
+        else {
+            for (size_t i = 0; i < cursor.active.size(); i++) {
+            #ifdef ARGSPARSER_INSTRUMENTATION
+                Detail::current_argument = &arguments[first_argument + i];
+                try {
+                    cursor.active[i].first->postProcess(*cursor.active[i].second);
+                }
+                catch (...) {
+                    Detail::current_argument = nullptr;
+                    throw;
+                }
+                Detail::current_argument = nullptr;
+            #else
+                cursor.active[i].first->postProcess(*cursor.active[i].second);
+            #endif
+            }
+        }
+
+        // Arguments missing from the command line are only looked up in
+        // their other sources once read. The configuration file is mapped
+        // now, so that a missing file is reported by the parse.
+        if (has_fallbacks) {
+            cursor.result.fallbacks_ = std::make_shared<ParseResult::Fallbacks>(registered_positionals.size(), registered_options.size());
+            if (!cursor.options.config_file.empty())
+                cursor.result.fallbacks_->config = std::make_shared<ConfigFile>(cursor.options.config_file);
+        }
+    };
+
+    void SchemaImpl::postProcess(Cursor& cursor, ThreadPool* pool) const{
+        // Every part of every argument is a task of its own, so that a single
+        // argument with many values still uses the whole pool. The pool does
+        // not run tasks from within tasks, so they are all started at once.
+        // Without a pool, arguments are not split.
+        const size_t part_size = pool != nullptr? cursor.options.part_size : std::numeric_limits<size_t>::max();
+        std::vector<std::pair<size_t, size_t>> tasks;
+        for (size_t i = 0; i < cursor.active.size(); i++) {
+            size_t parts = cursor.active[i].first->prepare(*cursor.active[i].second, part_size);
+            for (size_t j = 0; j < parts; j++) tasks.emplace_back(i, j);
+        }
+
+    #ifdef ARGSPARSER_INSTRUMENTATION
+        // Parts of the same argument may run at once, so each is timed apart
+        // and added to the statistics of its argument after the run.
+        std::vector<ArgumentStatistics>& arguments = cursor.result.statistics_->arguments;
+        const size_t first_argument = arguments.size() - cursor.active.size();
+        std::vector<ArgumentStatistics> part_statistics(tasks.size());
+        std::function<void(size_t)> process = [&cursor, &tasks, &part_statistics](size_t i){
+            Detail::current_argument = &part_statistics[i];
+            try {
+                cursor.active[tasks[i].first].first->process(*cursor.active[tasks[i].first].second, tasks[i].second);
+            }
+            catch (...) {
+                Detail::current_argument = nullptr;
+                throw;
+            }
+            Detail::current_argument = nullptr;
+        };
+    #else
+        std::function<void(size_t)> process = [&cursor, &tasks](size_t i){
+            cursor.active[tasks[i].first].first->process(*cursor.active[tasks[i].first].second, tasks[i].second);
+        };
+    #endif
+        if (pool != nullptr) pool->run(tasks.size(), process);
+        else for (size_t i = 0; i < tasks.size(); i++) process(i);
+    #ifdef ARGSPARSER_INSTRUMENTATION
+        for (size_t i = 0; i < tasks.size(); i++) {
+            arguments[first_argument + tasks[i].first].converter_ns += part_statistics[i].converter_ns;
+            arguments[first_argument + tasks[i].first].validator_ns += part_statistics[i].validator_ns;
+        }
+    #endif
+
+        // Asynchronous validations are awaited and callbacks are called from
+        // this thread, in the order the arguments were found, as they would
+        // be by a sequential parse.
+        for (size_t i = 0; i < cursor.active.size(); i++) {
+        #ifdef ARGSPARSER_INSTRUMENTATION
+            Detail::current_argument = &arguments[first_argument + i];
+            try {
+                cursor.active[i].first->complete(*cursor.active[i].second);
+            }
+            catch (...) {
+                Detail::current_argument = nullptr;
+                throw;
+            }
+            Detail::current_argument = nullptr;
+        #else
+            cursor.active[i].first->complete(*cursor.active[i].second);
+        #endif
+        }
+    };
+
+    void SchemaImpl::fallback(const Token& token, const ConfigFile* config, StatePointer& state,
+                              std::shared_ptr<const char>& buffer) const noexcept{
+        // Only positionals and options take input, so their containers are
+        // always input containers.
+        if (token.type != ArgType::Positional && token.type != ArgType::Option) return;
+        const InputContainer* container = static_cast<const InputContainer*>(getContainer(token));
+        if (container == nullptr || !container->hasFallback()) return;
+
+        std::pmr::memory_resource* resource = std::pmr::new_delete_resource();
+        std::string_view value;
+        Span<std::string_view> values;
+        try {
+            const char* variable = container->environment_.empty()? nullptr : std::getenv(container->environment_.c_str());
+            if (variable != nullptr) {
+                // The environment may change once read, so the value is copied.
+                size_t size = std::strlen(variable);
+                std::shared_ptr<char> copy = make_buffer(resource, size + 1);
+                std::memcpy(copy.get(), variable, size + 1);
+                buffer = copy;
+                value = std::string_view(copy.get(), size);
+                values = Span<std::string_view>(&value, 1);
+            }
+            if (values.size() == 0 && config != nullptr && !container->config_key_.empty())
+                values = config->find(container->config_key_);
+            if (values.size() == 0 && container->has_default_) {
+                value = container->default_value_;
+                values = Span<std::string_view>(&value, 1);
+            }
+            if (values.size() == 0) return;
+            state.reset(container->createState(resource));
+        }
+        catch (...) {
+            // Without memory for the state, the argument reads as missing.
+            buffer.reset();
+            return;
+        }
+
+        // The callback is only called for a valid input, so if the input was
+        // valid when the exception was thrown, the callback threw it and the
+        // error callback is called instead.
+        InputState& input = static_cast<InputState&>(*state);
+        auto reject = [container, &input](const char* reason){
+            const bool valid = input.validation;
+            input.validation = false;
+            input.validation_failure_reason = reason;
+            if (!valid || container->error_callback_ == nullptr) return;
+            try {
+                container->error_callback_(std::runtime_error(input.validation_failure_reason));
+            }
+            catch (...) {
+            }
+        };
+        try {
+            for (size_t i = 0; i < values.size() && i < container->getMaxInputs(); i++)
+                container->setActive(input, values[i]);
+            container->postProcess(input);
+        }
+        catch (const std::exception& e) {
+            reject(e.what());
+        }
+        catch (...) {
+            reject("Unknown error during post processing.");
+        }
+    };
+
+    CompiledSchema::CompiledSchema() :
+        schema_impl(std::make_shared<SchemaImpl>())
+        { };
+
+    CompiledSchema::CompiledSchema(const std::shared_ptr<const SchemaImpl>& schema) :
+        schema_impl(schema)
+        { };
+
+    const SchemaImpl* CompiledSchema::get() const noexcept{
+        return schema_impl.get();
+    };
+
+    Token CompiledSchema::isRegistered(const std::string& symbol) const noexcept{
+        return (isNameRegistered(symbol) || isIdentifierRegistered(symbol));
+    };
+
+    Token CompiledSchema::isNameRegistered(const std::string& name) const noexcept{
+        return schema_impl->findName(name);
+    };
+
+    Token CompiledSchema::isIdentifierRegistered(const std::string& identifier) const noexcept{
+        return schema_impl->lookup_table.find(identifier.data(), identifier.size());
+    };
+
+    Token CompiledSchema::isIdentifierRegistered(const char* identifier) const noexcept{
+        return schema_impl->lookup_table.find(identifier);
+    };
+
+    Token CompiledSchema::matchIdentifier(const std::string& identifier) const noexcept{
+        return schema_impl->matchIdentifier(identifier);
+    };
+
+    std::vector<std::string> CompiledSchema::suggestIdentifiers(const std::string& identifier, size_t max_distance, size_t max_results) const{
+        return schema_impl->identifier_trie.suggest(identifier, max_distance, max_results);
+    };
+
+    std::vector<Token> CompiledSchema::getRegisteredTokens() const{
+        std::vector<Token> tokens;
+        for(auto var : schema_impl->names)
+        {
+            tokens.push_back(var.second);
+        }
+        return tokens;
+    };
+
+    std::vector<std::string> CompiledSchema::getRegisteredNames() const{
+        std::vector<std::string> names;
+        for(auto var : schema_impl->names)
+        {
+            names.push_back(std::string(var.first));
+        }
+        return names;
+    };
+
+    const Container* CompiledSchema::getContainer(const std::string& name) const noexcept{
+        return getContainer(isRegistered(name));
+    };
+
+    const Container* CompiledSchema::getContainer(const Token& token) const noexcept{
+        return schema_impl->getContainer(token);
+    };
+
+    std::string CompiledSchema::getProgramName() const noexcept{
+        return schema_impl->program_name;
+    };
+
+    ParseResult CompiledSchema::parse(int argc, char* argv[], const ParseOptions& options) const{
+        ParseResult result(*this, options.resource);
+        schema_impl->parse(argc, argv, result, options);
+        return result;
+    };
+
+    ParseResult CompiledSchema::parseStream(int fd, char delimiter, const ParseOptions& options) const{
+        ParseResult result(*this, options.resource);
+        schema_impl->parseStream(fd, delimiter, result, options);
+        return result;
+    };
+}
@@ -0,0 +1,159 @@
+/**
+ * thread_pool.cpp
+ * 
+ * This file contains the implementation of the ThreadPool class.
+ * 
+ * Copyright (C) 2018 Renan Basilio. All rights reserved.
+ */
+
+#include <algorithm>
+#include <argsparser/thread_pool.h>
+
+namespace
+{
+    // The pool whose tasks the current thread is running, if any.
+    thread_local const ArgsParser::ThreadPool* current_pool = nullptr;
+}
+
+namespace ArgsParser
+{
+    ThreadPool::ThreadPool(size_t threads) :
+        size_(threads != 0? threads : std::max<size_t>(std::thread::hardware_concurrency(), 1)),
+        task_(nullptr),
+        generation_(0),
+        active_(0),
+        stopping_(false)
+    {
+        queues_.reset(new Queue[size_]);
+        workers_.reserve(size_ - 1);
+        for (size_t i = 0; i + 1 < size_; i++) {
+            workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    };
+
+    ThreadPool::~ThreadPool(){
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (size_t i = 0; i < workers_.size(); i++) workers_[i].join();
+    };
+
+    size_t ThreadPool::size() const noexcept{
+        return size_;
+    };
+
+    void ThreadPool::run(size_t count, const std::function<void(size_t)>& task){
+        if (count == 0) return;
+
+        // A run started from a task of this pool would wait for the run it is
+        // part of to end, so its tasks are run on this thread instead.
+        if (current_pool == this) {
+            std::exception_ptr error;
+            for (size_t i = 0; i < count; i++) {
+                try {
+                    task(i);
+                }
+                catch (...) {
+                    if (!error) error = std::current_exception();
+                }
+            }
+            if (error) std::rethrow_exception(error);
+            return;
+        }
+        std::lock_guard<std::mutex> run_lock(run_mutex_);
+
+        // Split the tasks evenly between the threads. No worker is running, so
+        // the queues can be written without locking them.
+        for (size_t i = 0; i < size_; i++) {
+            queues_[i].begin = count * i / size_;
+            queues_[i].end = count * (i + 1) / size_;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            error_ = nullptr;
+            active_ = workers_.size();
+            generation_++;
+        }
+        wake_.notify_all();
+
+        // The calling thread owns the last queue.
+        const ThreadPool* caller_pool = current_pool;
+        current_pool = this;
+        work(size_ - 1);
+        current_pool = caller_pool;
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this](){ return active_ == 0; });
+            task_ = nullptr;
+            error = error_;
+        }
+        if (error) std::rethrow_exception(error);
+    };
+
+    void ThreadPool::workerLoop(size_t self){
+        current_pool = this;
+        size_t generation = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this, generation](){ return stopping_ || generation_ != generation; });
+                if (stopping_) return;
+                generation = generation_;
+            }
+            work(self);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--active_ == 0) done_.notify_all();
+            }
+        }
+    };
+
+    void ThreadPool::work(size_t self){
+        size_t index;
+        while (next(self, index)) {
+            try {
+                (*task_)(index);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+        }
+    };
+
+    bool ThreadPool::next(size_t self, size_t& index){
+        Queue& own = queues_[self];
+        {
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.begin < own.end) {
+                index = own.begin++;
+                return true;
+            }
+        }
+
+        // Out of tasks, so steal the back half of the tasks of another thread.
+        for (size_t offset = 1; offset < size_; offset++) {
+            Queue& victim = queues_[(self + offset) % size_];
+            size_t begin, end;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.begin >= victim.end) continue;
+                begin = victim.begin + (victim.end - victim.begin) / 2;
+                end = victim.end;
+                victim.end = begin;
+            }
+            std::lock_guard<std::mutex> lock(own.mutex);
+            index = begin;
+            own.begin = begin + 1;
+            own.end = end;
+            return true;
+        }
+        return false;
+    };
+}
@@ -9,21 +9,41 @@
 
 #include<argsparser/util.h>
 
+namespace
+{
+    // Whether each character may appear in an identifier: letters and dashes.
+    struct IdentifierCharacters{
+        bool valid[256] = {};
+        IdentifierCharacters(){
+            for (char c = 'a'; c <= 'z'; c++) valid[(unsigned char)c] = true;
+            for (char c = 'A'; c <= 'Z'; c++) valid[(unsigned char)c] = true;
+            valid[(unsigned char)'-'] = true;
+        }
+    };
+    const IdentifierCharacters identifier_characters;
+}
+
 namespace ArgsTools
 {
-    bool check_identifier(const std::string& string){
+    // Returns the reason a string cannot be made into an identifier, or an
+    // empty string if it can.
+    static std::string find_identifier_error(const std::string& string){
 
-        // First check if this is a valid string.
-        const size_t invalid_char = string.find_first_not_of("-AaBbCcDdEeFfGgHhIiJjKkLlMmNnOoPpQqRrSsTtUuVvWwXxYyZz");
-        if(invalid_char != std::string::npos) {
-            throw std::invalid_argument( std::string("Invalid character '") + string.at(invalid_char) + std::string("'") );
+        // First check if this is a valid string. Characters are checked
+        // against a table rather than searched for in the set of valid ones.
+        for(size_t i = 0; i < string.length(); i++) {
+            if(!identifier_characters.valid[(unsigned char)string[i]])
+                return std::string("Invalid character '") + string[i] + std::string("'");
         }
         // Then check if the string contains at least one letter (and does not end in a dash)
         if(string.length() > 0 && string.at(string.length()-1) == '-'){
-            throw std::invalid_argument( "Identifier must not end in a dash.");
+            return "Identifier must not end in a dash.";
         }
+        return std::string();
+    }
 
-        // Next, check if string is correctly prefixed.
+    // Returns whether a valid string is correctly prefixed.
+    static bool is_prefixed(const std::string& string){
         if(string.length() == 2 && string.at(0) == '-') return true;
         size_t first_char = string.find_first_not_of('-');
         if(string.length()-first_char > 1 && first_char == 2) return true;
@@ -32,22 +52,39 @@ namespace ArgsTools
         return false;
     }
 
+    bool check_identifier(const std::string& string){
+        std::string error = find_identifier_error(string);
+        if (!error.empty()) throw std::invalid_argument(error);
+
+        // Next, check if string is correctly prefixed.
+        return is_prefixed(string);
+    }
+
     std::string make_identifier(const std::string& string){
+        std::string identifier;
+        std::string error = try_make_identifier(string, identifier);
+        if (!error.empty()) throw std::invalid_argument(error);
+        return identifier;
+    };
+
+    std::string try_make_identifier(const std::string& string, std::string& identifier){
+        std::string error = find_identifier_error(string);
+        if (!error.empty()) return error;
 
-        if (check_identifier(string)) return string;
+        identifier = string;
+        if (is_prefixed(string)) return error;
 
         size_t first_char = string.find_first_not_of('-');
 
         // If the string is valid but not correctly prefixed, remove any 
         // prefixing dashes and prefix with the correct amount.
-        std::string ret_string = string;
-        ret_string.replace(
+        identifier.replace(
             0,
             first_char,
             (string.length()-first_char == 1? "-":"--")
         );
         
-        return ret_string;
+        return error;
     };
 
     void print_error(const std::exception& e){
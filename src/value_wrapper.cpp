@@ -15,10 +15,14 @@ namespace ArgsParser
         return active;
     };
 
-    ValueWrapper::operator std::vector<std::string>() const noexcept {
+    ValueWrapper::operator std::vector<std::string>() const & noexcept {
         return user_input;
     };
 
+    ValueWrapper::operator std::vector<std::string>() && noexcept {
+        return std::move(user_input);
+    };
+
     ValueWrapper::operator std::string() const noexcept {
         return to_string();
     };
@@ -22,4 +22,32 @@ add_regex_test( DuplicateRegistrationFails "DUPREG_TEST_1 Registration Error: Na
 add_regex_test( DuplicateRegistrationFails2 "DUPREG_TEST_2 Registration Error: Identifier \"-t\" is already registered.")
 add_regex_test( InvalidRegistrationFails "INVREG_TEST_1 Registration Error: Invalid character \'!\'" "")
 add_regex_test( InvalidRegistrationFails2 "INVREG_TEST_2 Registration Error: Identifier must not end in a dash.")
-add_regex_test( BasicWorkflowTestINT "BASIC_WORKFLOW_TEST_INT: Returned value 1234567890i." --bwti 1234567890)
\ No newline at end of file
+add_regex_test( BasicWorkflowTestINT "BASIC_WORKFLOW_TEST_INT: Returned value 1234567890i." --bwti 1234567890)
+add_regex_test( IdentifierLookupIgnoresDashes "BASIC_WORKFLOW_TEST_INT: Returned value 77i." -bwti 77)
+add_regex_test( CompiledSchemaParsesIndependently "COMPILED_SCHEMA_TEST: 11 22 ab cd inactive 33" --bwti 33)
+add_regex_test( ZeroCopyParseReturnsViews "ZERO_COPY_TEST: 2 ab cd argv copy")
+add_regex_test( ArenaOwnsParserAllocations "ARENA_TEST: 15 cd arena arena arena heap --count")
+add_regex_test( ConcurrentReadsAreConsistent "THREAD_STRESS_TEST: 64 threads, 0 mismatches, \"\"")
+add_regex_test( BatchParseKeepsLineOrder "BATCH_TEST: 100 5890 109 1 Too many arguments to option basic workflow test <int>")
+add_regex_test( ResponseFilesExpandInPlace "RESPONSE_FILE_TEST: 4242 <hello world> <ab cd> Unable to open file \"response_missing.rsp\".")
+add_regex_test( StreamParseRecyclesBlocks "STREAM_TEST: 20000 kept_0 kept_19999 ab cd 0 active 488890")
+add_regex_test( LazyConversionIsDeferred "LAZY_TEST: 0 0 42 1 1 1 1 2 4 1 invalid 88")
+add_regex_test( ConvertersReportFailuresWithoutThrowing "EXPECTED_TEST: 8080 <\\\\|> 0 <Not a number.\\\\|Not a number.> 0 <Port out of range.\\\\|Port out of range.> rejected Registration Error: Name \"port\" is already registered.")
+add_regex_test( DefaultConvertersAreStrict "DEFAULT_CONVERTER_TEST: <Value \"12abc\" is not a valid number.> <Value \"256\" is out of range.> 2500 9000000000 text")
+add_regex_test( ListConverterSplitsElements "LIST_TEST: 10002 sum ok -9223372036854775808 1234567890123456789 3 65535 <Value \"70000\" is out of range.> <Value \"\" is not a valid number.> <Value \"x4\" is not a valid number.>")
+add_regex_test( ValueViewsDoNotCopy "VIEW_TEST: 3 aa cc same 0 0 3 bb 3")
+add_regex_test( TypedTokensSkipLookups "TOKEN_TEST: 8080 example 1 0 0 8080 same")
+add_regex_test( StaticParserResolvesAtCompileTime "STATIC_TEST: tool 1 16 3 cc in.txt out.txt <> 0 <Too many arguments to option.> 1")
+add_regex_test( BulkRegistrationReportsEveryConflict "BULKREG_TEST: 3 same 1 16 file.txt 0 0 <Registration Error: Identifier \"-q\" is already registered.\\; Invalid character '!'\\; Identifier \"-l\" is already registered.>")
+add_regex_test( ParserCopiesShareSchema "SHARED_SCHEMA_TEST: shared copied 6 4 0 16 kept")
+add_regex_test( HelpTextIsOrderedWrappedAndCached "HELP_TEST: usage: tool \\\\[file\\\\] \\\\[options\\\\]\\\\|    -z, --zeta +Enables the last\\\\| +letter of the\\\\| +alphabet for every\\\\| +later argument\\\\.\\\\|    -a +Enables the first\\\\| +letter\\\\.\\\\|\\\\|options:\\\\|    -j, --jobs \\\\[<count>\\\\.\\\\.\\\\.\\\\] +Runs jobs\\\\.\\\\| cached invalidated default")
+add_regex_test( IdentifierTrieMatchesAndSuggests "TRIE_TEST: 1 0 1 0 1 --verbose 1 16 <Unknown argument \"--verison\"\\\\. Did you mean \"--version\"\\\\?>")
+add_regex_test( BundledArgumentsAreSplit "BUNDLE_TEST: 1 1 0 8 3 out <Switch color does not take a value\\\\.> 110")
+add_regex_test( LayeredSourcesAreMergedLazily "LAYERED_TEST: 16 env\\\\.example edge 1 8080 fast 0 0 1 debug")
+add_regex_test( FallbackCallbacksAreContained "FALLBACK_CALLBACK_TEST: 1 2 3 <Callback failed\\\\.>")
+add_regex_test( InstrumentationRecordsParse "INSTRUMENTATION_TEST: consistent")
+add_regex_test( ParallelPostProcessingKeepsOrder "PARALLEL_TEST: name,ids,all, 1 3000 same 1499 <Identifier 0 is out of range\\.> same")
+add_regex_test( AsyncValidatorsOverlap "ASYNC_TEST: 6 <No file \"missing\"\\.>,<Port 0 is in use\\.>,verbose, 2 kept")
+add_regex_test( LazyCallbackErrorsAreReported "LAZY_ERROR_TEST: 12 <Callback failed\\.> <Callback failed\\.>")
+add_regex_test( LazyReadersWaitForCallbacks "LAZY_READER_TEST: 15 0")
+add_regex_test( NestedPoolRunsInline "NESTED_POOL_TEST: 8 7968")
\ No newline at end of file
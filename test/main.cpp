@@ -1,11 +1,45 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <sstream>
+#include <thread>
 #include <argsparser.h>
 #include <exception>
 
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h>
+    #define pipe(fds) _pipe(fds, 1 << 16, _O_BINARY)
+    #define write _write
+    #define close _close
+    #define setenv(name, value, overwrite) _putenv_s(name, value)
+#else
+    #include <unistd.h>
+#endif
+
 void print_string(std::string string){
     std::cout << string << std::endl;
 }
 
+// Builds a mutable argv array from a list of strings. The strings must outlive the array.
+std::vector<char*> make_argv(std::vector<std::string>& arguments){
+    std::vector<char*> result;
+    for(size_t i = 0; i < arguments.size(); i++) result.push_back(&arguments[i][0]);
+    result.push_back(nullptr);
+    return result;
+}
+
+// The arguments of the static parser test.
+static constexpr ArgsParser::StaticArgument static_arguments[] = {
+    ArgsParser::staticSwitch("verbose", {"v", "verbose"}),
+    ArgsParser::staticOption("jobs", {"j", "jobs"}),
+    ArgsParser::staticOption("include", {"I", "--include"}, 3),
+    ArgsParser::staticPositional("input"),
+    ArgsParser::staticPositional("output"),
+};
+
 int main(int argc, char* argv[]){
     // Initialization Test
     ArgsParser::Parser testParser = ArgsParser::Parser();
@@ -67,6 +101,731 @@ int main(int argc, char* argv[]){
     testParser.parse(argc, argv);
     std::cout << "BASIC_WORKFLOW_TEST_INT: " << "Returned value " << std::to_string((int)(testParser.getValue<int>("bwti"))) << "i." << std::endl;
 
+    // Compiled Schema Test
+    ArgsParser::CompiledSchema schema = testParser.compile();
+    std::vector<std::string> first_line = {"worker", "--bwti", "11"};
+    std::vector<std::string> second_line = {"worker", "--bwti", "22", "-t", "ab", "cd"};
+    std::vector<char*> first_argv = make_argv(first_line);
+    std::vector<char*> second_argv = make_argv(second_line);
+    ArgsParser::ParseResult first_result = schema.parse((int)first_line.size(), first_argv.data());
+    ArgsParser::ParseResult second_result = schema.parse((int)second_line.size(), second_argv.data());
+    std::cout << "COMPILED_SCHEMA_TEST: "
+              << (int)first_result.getValue<int>("bwti") << " "
+              << (int)second_result.getValue<int>("bwti") << " "
+              << second_result.getValue("test").to_string() << " "
+              << (first_result.getValue("test") ? "active" : "inactive") << " "
+              << (int)testParser.getValue<int>("bwti") << std::endl;
+
+    // Zero Copy Parse Test
+    ArgsParser::ParseOptions zero_copy;
+    zero_copy.zero_copy = true;
+    ArgsParser::ParseResult view_result = schema.parse((int)second_line.size(), second_argv.data(), zero_copy);
+    ArgsParser::Span<std::string_view> views = view_result.getValueView("test");
+    ArgsParser::Span<std::string_view> copies = second_result.getValueView("test");
+    std::cout << "ZERO_COPY_TEST: "
+              << views.size() << " " << views[0] << " " << views[1] << " "
+              << (views[0].data() == second_argv[4] ? "argv" : "copy") << " "
+              << (copies[0].data() == second_argv[4] ? "argv" : "copy") << std::endl;
+
+    // Arena Test
+    // Every container of the parser and every value of its results should be
+    // allocated from the arena, which can not grow past its initial buffer.
+    static char arena_buffer[64 * 1024];
+    std::pmr::monotonic_buffer_resource arena(arena_buffer, sizeof(arena_buffer), std::pmr::null_memory_resource());
+    {
+        ArgsParser::Parser arenaParser(&arena);
+        arenaParser.registerOption<int>("count", {"c", "count"}, "count", "", 1, nullptr,
+            [](std::string value){ return std::stoi(value); });
+        arenaParser.registerOption("list", {"l"}, "items", "", 2);
+        std::vector<std::string> arena_line = {"worker", "--count", "15", "-l", "ab", "cd"};
+        std::vector<char*> arena_argv = make_argv(arena_line);
+        arenaParser.parse((int)arena_line.size(), arena_argv.data());
+
+        const ArgsParser::Container* count = arenaParser.getContainer("count");
+        ArgsParser::Container* count_clone = count->clone(std::pmr::new_delete_resource());
+        ArgsParser::Parser copiedParser(arenaParser);
+        std::cout << "ARENA_TEST: "
+                  << (int)arenaParser.getValue<int>("count") << " "
+                  << arenaParser.getValue("list")[1] << " "
+                  << (count->getMemoryResource() == &arena ? "arena" : "heap") << " "
+                  << (arenaParser.getResult().getMemoryResource() == &arena ? "arena" : "heap") << " "
+                  << (copiedParser.getContainer("count")->getMemoryResource() == &arena ? "arena" : "heap") << " "
+                  << (count_clone->getMemoryResource() == &arena ? "arena" : "heap") << " "
+                  << count_clone->getIdentifiers()[1] << std::endl;
+        count_clone->destroy();
+    }
+
+    // Thread Stress Test
+    // Once parsed, values should be readable from many threads at once. Built
+    // with ARGSPARSER_TSAN, this test also checks that no reads race.
+    ArgsParser::Parser sharedParser;
+    ArgsParser::Token shared_count = sharedParser.registerOption<int>("count", {"c", "count"}, "count", "", 1, nullptr,
+        [](std::string value){ return std::stoi(value); });
+    ArgsParser::Token shared_list = sharedParser.registerOption("list", {"l", "list"}, "items", "", 2);
+    sharedParser.registerSwitch("verbose", {"v", "verbose"});
+    std::vector<std::string> shared_line = {"worker", "--count", "42", "--list", "ab", "cd", "--verbose"};
+    std::vector<char*> shared_argv = make_argv(shared_line);
+    sharedParser.parse((int)shared_line.size(), shared_argv.data());
+
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 64; t++) {
+        readers.emplace_back([&](){
+            for (int i = 0; i < 500; i++) {
+                bool valid =
+                    (int)sharedParser.getValue<int>("count") == 42 &&
+                    (int)sharedParser.getValue<int>(shared_count) == 42 &&
+                    sharedParser.getValue("list")[1] == "cd" &&
+                    sharedParser.getValueView(shared_list).size() == 2 &&
+                    sharedParser.getValue("verbose") &&
+                    !sharedParser.getValue("missing") &&
+                    sharedParser.isIdentifierRegistered("-l") == shared_list &&
+                    !sharedParser.isIdentifierRegistered("--missing") &&
+                    sharedParser.getContainer(ArgsParser::NULL_TOKEN) == nullptr &&
+                    sharedParser.getResult().isActive(shared_count);
+                if (!valid) mismatches++;
+            }
+        });
+    }
+    for (size_t t = 0; t < readers.size(); t++) readers[t].join();
+    std::cout << "THREAD_STRESS_TEST: " << readers.size() << " threads, "
+              << mismatches.load() << " mismatches, \"" << sharedParser.error_description << "\"" << std::endl;
+
+    // Batch Test
+    // Lines should be parsed in parallel but returned in order, with errors
+    // reported per line.
+    std::vector<std::vector<std::string>> batch_lines;
+    for (int i = 10; i < 110; i++) batch_lines.push_back({"worker", "--bwti", std::to_string(i)});
+    batch_lines[50] = {"worker", "--bwti", "11", "--bwti", "22"};
+    ArgsParser::ThreadPool pool(4);
+    std::vector<ArgsParser::BatchResult> batch = ArgsParser::parseBatch(schema, batch_lines, pool);
+    int batch_sum = 0;
+    size_t batch_failures = 0;
+    for (size_t i = 0; i < batch.size(); i++) {
+        if (batch[i].success) batch_sum += (int)batch[i].result.getValue<int>("bwti");
+        else batch_failures++;
+    }
+    std::cout << "BATCH_TEST: " << batch.size() << " " << batch_sum << " "
+              << (int)batch[99].result.getValue<int>("bwti") << " " << batch_failures << " "
+              << batch[50].error << std::endl;
+
+    // Response File Test
+    // Arguments of a response file should be read in its place, including
+    // those of nested files, with quotes and escapes removed.
+    std::ofstream("response_nested.rsp") << "--bwti\n4242\n";
+    std::ofstream("response_main.rsp") << "@response_nested.rsp -t \"hello world\"  ab\\ 'c'd\n";
+    std::vector<std::string> response_line = {"worker", "@response_main.rsp"};
+    std::vector<char*> response_argv = make_argv(response_line);
+    ArgsParser::ParseOptions expand;
+    expand.expand_response_files = true;
+    ArgsParser::ParseResult response_result = schema.parse((int)response_line.size(), response_argv.data(), expand);
+    std::string missing_file_error;
+    try {
+        std::vector<std::string> missing_line = {"worker", "@response_missing.rsp"};
+        std::vector<char*> missing_argv = make_argv(missing_line);
+        schema.parse((int)missing_line.size(), missing_argv.data(), expand);
+    }
+    catch (const std::exception& e) {
+        missing_file_error = e.what();
+    }
+    std::cout << "RESPONSE_FILE_TEST: "
+              << (int)response_result.getValue<int>("bwti") << " <"
+              << response_result.getValue("test")[0] << "> <"
+              << response_result.getValue("test")[1] << "> "
+              << missing_file_error << std::endl;
+
+    // Stream Test
+    // Arguments read from a pipe should be parsed as they arrive. Values
+    // consumed by the sink should not be stored, while other values must
+    // survive the blocks they were read into being recycled.
+    ArgsParser::Parser streamParser;
+    streamParser.registerOption("files", {"--files"}, "file", "", std::numeric_limits<size_t>::max());
+    streamParser.registerOption("test", {"-t"}, "value", "", 2);
+    ArgsParser::Token stream_files = streamParser.registerOption("sink", {"--sink"}, "file", "", std::numeric_limits<size_t>::max());
+    int stream_pipe[2];
+    if (pipe(stream_pipe) != 0) return 1;
+    std::thread stream_writer([&stream_pipe](){
+        std::string data = std::string("-t\0ab\0--sink\0", 14);
+        for (int i = 0; i < 50000; i++) data += "sunk_" + std::to_string(i) + '\0';
+        data += std::string("--files\0", 8);
+        for (int i = 0; i < 20000; i++) data += "kept_" + std::to_string(i) + '\0';
+        data += std::string("-t\0cd", 5);
+        for (size_t written = 0; written < data.size(); ) {
+            int count = (int)write(stream_pipe[1], data.data() + written, (unsigned)std::min<size_t>(data.size() - written, 4096));
+            if (count <= 0) break;
+            written += count;
+        }
+        close(stream_pipe[1]);
+    });
+    size_t sunk = 0;
+    ArgsParser::ParseOptions stream_options;
+    stream_options.value_sink = [&sunk, stream_files](const ArgsParser::Token& token, std::string_view value){
+        if (!(token == stream_files)) return false;
+        sunk += value.size();
+        return true;
+    };
+    streamParser.parseStream(stream_pipe[0], '\0', stream_options);
+    stream_writer.join();
+    close(stream_pipe[0]);
+    ArgsParser::Span<std::string_view> kept = streamParser.getValueView("files");
+    std::cout << "STREAM_TEST: " << kept.size() << " " << kept[0] << " " << kept[19999] << " "
+              << streamParser.getValue("test")[0] << " " << streamParser.getValue("test")[1] << " "
+              << streamParser.getValueView("sink").size() << " " << (streamParser.getValue("sink") ? "active" : "inactive") << " "
+              << sunk << std::endl;
+
+    // Lazy Conversion Test
+    // Lazy arguments should only be converted, and call their callback, the
+    // first time they are read, and only once. Forcing the conversions of a
+    // result should convert every pending argument.
+    ArgsParser::Parser lazyParser;
+    std::atomic<int> lazy_conversions(0);
+    int lazy_callbacks = 0;
+    int lazy_errors = 0;
+    ArgsParser::Token lazy_number = lazyParser.registerOption<int>(
+        "number", {"--number"}, "integer", "", 1,
+        [&lazy_callbacks](){ lazy_callbacks++; },
+        [&lazy_conversions](std::string input)->int{ lazy_conversions++; return std::stoi(input); },
+        nullptr,
+        [&lazy_errors](const std::exception&){ lazy_errors++; }
+    );
+    lazyParser.registerOption<int>(
+        "other", {"--other"}, "integer", "", 1, nullptr,
+        [&lazy_conversions](std::string input)->int{ lazy_conversions++; return std::stoi(input); }
+    );
+    lazyParser.setLazy(lazy_number);
+    lazyParser.setLazy("other");
+    std::vector<std::string> lazy_line = {"worker", "--number", "42", "--other", "77"};
+    std::vector<char*> lazy_argv = make_argv(lazy_line);
+    lazyParser.parse((int)lazy_line.size(), lazy_argv.data());
+    std::cout << "LAZY_TEST: " << lazy_conversions << " " << lazy_callbacks;
+    int lazy_value = lazyParser.getValue<int>(lazy_number);
+    std::cout << " " << lazy_value << " " << lazy_conversions << " " << lazy_callbacks;
+    lazyParser.getValue<int>(lazy_number);
+    std::cout << " " << lazy_conversions << " " << lazy_callbacks;
+    lazyParser.forceConversions();
+    std::cout << " " << lazy_conversions;
+    ArgsParser::ThreadPool lazy_pool(4);
+    std::vector<std::string> lazy_error_line = {"worker", "--number", "xx", "--other", "88"};
+    std::vector<char*> lazy_error_argv = make_argv(lazy_error_line);
+    ArgsParser::ParseResult lazy_result = lazyParser.compile().parse((int)lazy_error_line.size(), lazy_error_argv.data());
+    lazy_result.forceConversions(lazy_pool);
+    std::cout << " " << lazy_conversions << " " << lazy_errors << " "
+              << (lazy_result.getState(lazy_number) != nullptr && !static_cast<const ArgsParser::InputState*>(lazy_result.getState(lazy_number))->getValidation().first ? "invalid" : "valid")
+              << " " << (int)lazy_result.getValue<int>("other") << std::endl;
+
+    // Lazy Error Test
+    // A lazy callback that throws should reject the input when the value is
+    // read and reach the error handler, rather than escape the read.
+    ArgsParser::Parser lazyErrorParser;
+    std::string lazy_error_reason;
+    lazyErrorParser.registerOption<int>("count", {"--count"}, "integer", "", 1,
+        [](){ throw std::runtime_error("Callback failed."); },
+        [](std::string input)->int{ return std::stoi(input); }, nullptr,
+        [&lazy_error_reason](const std::exception& e){ lazy_error_reason = e.what(); }
+    );
+    lazyErrorParser.setLazy("count");
+    std::vector<std::string> lazy_error_test_line = {"worker", "--count", "12"};
+    std::vector<char*> lazy_error_test_argv = make_argv(lazy_error_test_line);
+    ArgsParser::ParseResult lazy_error_result = lazyErrorParser.compile().parse((int)lazy_error_test_line.size(), lazy_error_test_argv.data());
+    int lazy_error_value = lazy_error_result.getValue<int>("count");
+    const ArgsParser::InputState* lazy_error_state = static_cast<const ArgsParser::InputState*>(lazy_error_result.getState(lazyErrorParser.isRegistered("count")));
+    std::cout << "LAZY_ERROR_TEST: " << lazy_error_value << " <" << lazy_error_reason << "> <" << lazy_error_state->getValidation().second << ">" << std::endl;
+
+    // Lazy Reader Test
+    // Every thread reading a lazy argument should only return once its
+    // callback has run, whichever thread runs it.
+    ArgsParser::Parser lazyReaderParser;
+    std::atomic<bool> lazy_reader_called(false);
+    lazyReaderParser.registerOption<int>("count", {"--count"}, "integer", "", 1,
+        [&lazy_reader_called](){
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            lazy_reader_called = true;
+        },
+        [](std::string input)->int{ return std::stoi(input); }
+    );
+    lazyReaderParser.setLazy("count");
+    std::vector<std::string> lazy_reader_line = {"worker", "--count", "15"};
+    std::vector<char*> lazy_reader_argv = make_argv(lazy_reader_line);
+    ArgsParser::ParseResult lazy_reader_result = lazyReaderParser.compile().parse((int)lazy_reader_line.size(), lazy_reader_argv.data());
+    std::atomic<int> lazy_reader_early(0);
+    std::vector<std::thread> lazy_readers;
+    for (size_t i = 0; i < 4; i++) {
+        lazy_readers.emplace_back([&lazy_reader_result, &lazy_reader_called, &lazy_reader_early](){
+            lazy_reader_result.getValue<int>("count");
+            if (!lazy_reader_called) lazy_reader_early++;
+        });
+    }
+    for (size_t i = 0; i < lazy_readers.size(); i++) lazy_readers[i].join();
+    std::cout << "LAZY_READER_TEST: " << (int)lazy_reader_result.getValue<int>("count") << " " << lazy_reader_early << std::endl;
+
+    // Expected Test
+    // Converters and validators returning Expected and Status should report
+    // failures to the error handler with their reason, and duplicate
+    // registrations should be rejected without throwing when asked not to.
+    ArgsParser::Parser expectedParser(true);
+    std::string expected_error;
+    expectedParser.registerOption<int>(
+        "port", {"--port"}, "port", "", 1, nullptr,
+        [](std::string_view input) -> ArgsParser::Expected<int> {
+            if (input.find_first_not_of("0123456789") != std::string_view::npos) return ArgsParser::Failure("Not a number.");
+            return std::stoi(std::string(input));
+        },
+        [](const int& port){ return port < 65536? ArgsParser::Status() : ArgsParser::Failure("Port out of range."); },
+        [&expected_error](const std::exception& e){ expected_error = e.what(); }
+    );
+    ArgsParser::Token expected_duplicate = expectedParser.registerOption<int>("port", {"--other-port"});
+    std::string duplicate_error = expectedParser.error_description;
+    ArgsParser::CompiledSchema expected_schema = expectedParser.compile();
+    std::vector<std::string> expected_lines[] = {{"worker", "--port", "8080"}, {"worker", "--port", "http"}, {"worker", "--port", "99999"}};
+    std::cout << "EXPECTED_TEST:";
+    for (std::vector<std::string>& line : expected_lines) {
+        std::vector<char*> line_argv = make_argv(line);
+        ArgsParser::ParseResult line_result = expected_schema.parse((int)line.size(), line_argv.data());
+        std::pair<bool, std::string> validation = static_cast<const ArgsParser::InputState*>(
+            line_result.getState(expected_schema.isRegistered("port")))->getValidation();
+        std::cout << " " << (int)line_result.getValue<int>("port") << " <" << validation.second << "|" << expected_error << ">";
+    }
+    std::cout << " " << (expected_duplicate == ArgsParser::NULL_TOKEN ? "rejected" : "accepted") << " " << duplicate_error << std::endl;
+
+    // Default Converter Test
+    // Typed arguments registered without a converter should convert numbers
+    // strictly, rejecting trailing characters and values out of range.
+    ArgsParser::Parser defaultParser;
+    defaultParser.registerOption<int>("count", {"--count"}, "count", "", 2);
+    defaultParser.registerOption<unsigned char>("byte", {"--byte"}, "byte", "", 2);
+    defaultParser.registerOption<double>("ratio", {"--ratio"}, "ratio");
+    defaultParser.registerOption<long long>("large", {"--large"}, "large");
+    defaultParser.registerOption<std::string>("label", {"--label"}, "label");
+    std::vector<std::string> default_line = {"worker", "--count", "12", "12abc", "--byte", "255", "256",
+                                             "--ratio", "2.5e3", "--large", "9000000000", "--label", "text"};
+    std::vector<char*> default_argv = make_argv(default_line);
+    defaultParser.parse((int)default_line.size(), default_argv.data());
+    auto validation_of = [&defaultParser](const std::string& name){
+        return static_cast<const ArgsParser::InputState*>(
+            defaultParser.getResult().getState(defaultParser.isRegistered(name)))->getValidation().second;
+    };
+    std::cout << "DEFAULT_CONVERTER_TEST: <" << validation_of("count") << "> <" << validation_of("byte") << "> "
+              << (double)defaultParser.getValue<double>("ratio") << " "
+              << (long long)defaultParser.getValue<long long>("large") << " "
+              << (std::string)defaultParser.getValue<std::string>("label") << std::endl;
+
+    // List Converter Test
+    // Lists should convert to one value per element, across scan blocks and
+    // at the limits of the type, and reject empty or invalid elements.
+    ArgsParser::Parser listParser;
+    listParser.registerOption<long long>("ids", {"--ids"}, "ids", "", 1, nullptr, ArgsParser::ListConverter<long long>());
+    listParser.registerOption<unsigned short>("ports", {"--ports"}, "ports", "", 2, nullptr, ArgsParser::ListConverter<unsigned short>(':'));
+    std::string ids = "12";
+    long long id_sum = 12;
+    for (long long i = 1; i < 10000; i++) {
+        ids += "," + std::to_string(i * 7919);
+        id_sum += i * 7919;
+    }
+    ids += ",-9223372036854775808,1234567890123456789";
+    std::vector<std::string> list_line = {"worker", "--ids", ids, "--ports", "80:443:65535", "70000"};
+    std::vector<char*> list_argv = make_argv(list_line);
+    listParser.parse((int)list_line.size(), list_argv.data());
+    std::vector<long long> id_values = listParser.getValue<long long>("ids");
+    long long list_sum = 0;
+    for (size_t i = 0; i + 2 < id_values.size(); i++) list_sum += id_values[i];
+    std::vector<unsigned short> port_values = listParser.getValue<unsigned short>("ports");
+    std::cout << "LIST_TEST: " << id_values.size() << " " << (list_sum == id_sum ? "sum ok" : "sum mismatch") << " "
+              << id_values[id_values.size() - 2] << " " << id_values.back() << " "
+              << port_values.size() << " " << port_values[2] << " <"
+              << static_cast<const ArgsParser::InputState*>(listParser.getResult().getState(listParser.isRegistered("ports")))->getValidation().second << ">";
+    for (std::string bad : {"12,,34", "12,x4"}) {
+        std::vector<std::string> bad_line = {"worker", "--ids", bad};
+        std::vector<char*> bad_argv = make_argv(bad_line);
+        listParser.parse((int)bad_line.size(), bad_argv.data());
+        std::cout << " <" << static_cast<const ArgsParser::InputState*>(listParser.getResult().getState(listParser.isRegistered("ids")))->getValidation().second << ">";
+    }
+    std::cout << std::endl;
+
+    // Value View Test
+    // Typed values should be readable in place, the same storage being
+    // returned on every call, and wrappers should give up their values when
+    // converted from a temporary.
+    ArgsParser::Parser viewParser;
+    viewParser.registerOption<std::string>("include", {"--include"}, "path", "", 3);
+    std::vector<std::string> view_line = {"worker", "--include", "aa", "bb", "cc"};
+    std::vector<char*> view_argv = make_argv(view_line);
+    viewParser.parse((int)view_line.size(), view_argv.data());
+    ArgsParser::Span<std::string> includes = viewParser.getValueView<std::string>("include");
+    std::vector<std::string> moved_includes = viewParser.getValue<std::string>("include");
+    ArgsParser::TypedValueWrapper<std::string> include_wrapper = viewParser.getValue<std::string>("include");
+    ArgsParser::TypedValueWrapper<std::string> moved_wrapper = std::move(include_wrapper);
+    std::cout << "VIEW_TEST: " << includes.size() << " " << includes.front() << " " << includes.back() << " "
+              << (includes.data() == viewParser.getValueView<std::string>("include").data() ? "same" : "copied") << " "
+              << viewParser.getValueView<int>("include").size() << " "
+              << viewParser.getValueView<std::string>("missing").size() << " "
+              << moved_includes.size() << " " << moved_wrapper[1] << " "
+              << ((std::vector<std::string>)viewParser.getValue("include")).size() << std::endl;
+
+    // Typed Token Test
+    // Typed tokens should read values without checking their type, and still
+    // work wherever a plain token is expected.
+    ArgsParser::Parser tokenParser;
+    ArgsParser::TypedToken<int> port_token = tokenParser.registerOption<int>("port", {"--port"});
+    ArgsParser::TypedToken<std::string> host_token = tokenParser.registerPositional<std::string>("host", "host");
+    ArgsParser::TypedToken<int> unused_token = tokenParser.registerOption<int>("unused", {"--unused"});
+    std::vector<std::string> token_line = {"worker", "--port", "8080", "example"};
+    std::vector<char*> token_argv = make_argv(token_line);
+    tokenParser.parse((int)token_line.size(), token_argv.data());
+    int port_value = tokenParser.getValue(port_token);
+    std::cout << "TOKEN_TEST: " << port_value << " " << (std::string)tokenParser.getValue(host_token) << " "
+              << tokenParser.getValueView(port_token).size() << " "
+              << (bool)tokenParser.getValue(unused_token) << " "
+              << (bool)tokenParser.getValue(ArgsParser::TypedToken<int>()) << " "
+              << (std::string)tokenParser.getValue(static_cast<const ArgsParser::Token&>(port_token)) << " "
+              << (tokenParser.isRegistered("port") == port_token ? "same" : "different") << std::endl;
+
+    // Static Parser Test
+    // Identifiers should resolve at compile time, and command lines should be
+    // parsed with the same rules as a Parser.
+    using StaticTool = ArgsParser::StaticParser<static_arguments>;
+    static_assert(StaticTool::findIdentifier("--jobs") == 1 && StaticTool::findIdentifier("-include") == 2 &&
+        StaticTool::findIdentifier("I") == 2 && StaticTool::findIdentifier("--missing") == StaticTool::NOT_FOUND,
+        "Static identifiers should resolve at compile time.");
+    constexpr size_t include_index = StaticTool::indexOf("include");
+    std::vector<std::string> static_line = {"/usr/bin/tool", "in.txt", "-v", "--jobs", "16", "-I", "aa", "bb", "cc", "out.txt", "--unknown"};
+    std::vector<char*> static_argv = make_argv(static_line);
+    ArgsParser::StaticParseResult<static_arguments> static_result = StaticTool::parse((int)static_line.size(), static_argv.data());
+    std::vector<std::string> static_bad_line = {"tool", "--jobs", "16", "--jobs", "32"};
+    std::vector<char*> static_bad_argv = make_argv(static_bad_line);
+    ArgsParser::StaticParseResult<static_arguments> static_bad = StaticTool::parse((int)static_bad_line.size(), static_bad_argv.data());
+    std::cout << "STATIC_TEST: " << static_result.getProgramName() << " " << static_result.isActive("verbose") << " "
+              << static_result.getValue<int>("jobs").value() << " "
+              << static_result.getValueView(include_index).size() << " " << static_result.getValueView(include_index).back() << " "
+              << static_result.getValue("input") << " " << static_result.getValue("output") << " <"
+              << static_result.getError() << "> " << static_result.isActive("missing") << " <"
+              << static_bad.getError() << "> " << static_bad.getErrorArgument() << std::endl;
+
+    // Bulk Registration Test
+    // A batch should register in order, and a batch with conflicts should
+    // report all of them and register nothing.
+    ArgsParser::Parser bulkParser;
+    bulkParser.registerSwitch("quiet", {"q", "quiet"});
+    std::vector<ArgsParser::ArgumentSpec> bulk_specs(3);
+    bulk_specs[0].type = ArgsParser::ArgType::Switch;
+    bulk_specs[0].name = "verbose";
+    bulk_specs[0].identifiers = {"v", "verbose"};
+    bulk_specs[1].type = ArgsParser::ArgType::Option;
+    bulk_specs[1].name = "jobs";
+    bulk_specs[1].identifiers = {"j", "jobs"};
+    bulk_specs[2].type = ArgsParser::ArgType::Positional;
+    bulk_specs[2].name = "input";
+    std::vector<ArgsParser::Token> bulk_tokens = bulkParser.registerMany(bulk_specs);
+    std::vector<ArgsParser::ArgumentSpec> bulk_conflicts(bulk_specs.begin(), bulk_specs.begin() + 2);
+    bulk_conflicts[0].name = "loud";
+    bulk_conflicts[0].identifiers = {"l", "--q"};
+    bulk_conflicts[1].name = "threads";
+    bulk_conflicts[1].identifiers = {"t", "loud!", "l"};
+    std::vector<ArgsParser::Token> bulk_failed = bulkParser.registerMany(bulk_conflicts);
+    std::vector<std::string> bulk_line = {"tool", "-v", "--jobs", "16", "file.txt"};
+    std::vector<char*> bulk_argv = make_argv(bulk_line);
+    bulkParser.parse((int)bulk_line.size(), bulk_argv.data());
+    std::cout << "BULKREG_TEST: " << bulk_tokens.size() << " "
+              << (bulkParser.isRegistered("jobs") == bulk_tokens[1] ? "same" : "different") << " "
+              << (bool)bulkParser.getValue("verbose") << " " << (std::string)bulkParser.getValue("jobs") << " "
+              << (std::string)bulkParser.getValue("input") << " " << bulk_failed.size() << " "
+              << (bool)bulkParser.isRegistered("threads") << " <" << bulkParser.error_description << ">" << std::endl;
+
+    // Shared Schema Test
+    // Copies should share the arguments of the original until one of them
+    // registers another, and then keep their own.
+    ArgsParser::Parser templateCopy(bulkParser);
+    bool shared_before = templateCopy.getContainer("jobs") == bulkParser.getContainer("jobs");
+    templateCopy.registerSwitch("extra", {"x", "extra"});
+    bool shared_after = templateCopy.getContainer("jobs") == bulkParser.getContainer("jobs");
+    templateCopy.parse((int)bulk_line.size(), bulk_argv.data());
+    const ArgsParser::Container* parsed_container = templateCopy.getContainer("jobs");
+    templateCopy.registerSwitch("late", {"late"});
+    bool shared_after_parse = templateCopy.getContainer("jobs") == parsed_container;
+    std::cout << "SHARED_SCHEMA_TEST: " << (shared_before ? "shared" : "copied") << " "
+              << (shared_after ? "shared" : "copied") << " "
+              << templateCopy.getRegisteredNames().size() << " " << bulkParser.getRegisteredNames().size() << " "
+              << (bool)bulkParser.isRegistered("extra") << " " << (std::string)templateCopy.getValue("jobs") << " "
+              << (shared_after_parse ? "kept" : "copied") << std::endl;
+
+    // Help Text Test
+    // Usage text should list arguments in registration order, wrap
+    // descriptions to the width given and be cached until a registration.
+    ArgsParser::Parser helpParser;
+    helpParser.setProgramName("tool");
+    helpParser.registerSwitch("zeta", {"z", "zeta"}, "Enables the last letter of the alphabet for every later argument.");
+    helpParser.registerSwitch("alpha", {"a"}, "Enables the first letter.");
+    helpParser.registerOption("jobs", {"j", "jobs"}, "count", "Runs jobs.", 2);
+    helpParser.registerPositional("input", "file");
+    std::shared_ptr<const std::string> help_text = helpParser.getHelpText(44);
+    bool help_cached = helpParser.getHelpText(44) == help_text;
+    helpParser.registerSwitch("beta", {"b"});
+    bool help_invalidated = helpParser.getHelpText(44) != help_text;
+    std::string help_line = *help_text;
+    for (char& character : help_line) if (character == '\n') character = '|';
+    std::ostringstream help_stream;
+    setenv("COLUMNS", "44", 1);
+    ArgsParser::autohelper(&helpParser, help_stream);
+    unsetenv("COLUMNS");
+    bool help_default_width = help_stream.str() == *helpParser.getHelpText(80);
+    std::cout << "HELP_TEST: " << help_line << " " << (help_cached ? "cached" : "rendered") << " "
+              << (help_invalidated ? "invalidated" : "stale") << " " << (help_default_width ? "default" : "terminal") << std::endl;
+
+    // Abbreviation and Suggestion Test
+    // Unambiguous abbreviations should resolve, and unknown identifiers should
+    // be reported along with the closest registered ones.
+    ArgsParser::Parser trieParser;
+    trieParser.registerSwitch("verbose", {"verbose"});
+    trieParser.registerSwitch("version", {"version"});
+    ArgsParser::Token trie_level = trieParser.registerOption("level", {"l", "level", "levels"});
+    std::vector<std::string> trie_suggestions = trieParser.suggestIdentifiers("--verbsoe");
+    std::vector<std::string> trie_line = {"tool", "--verb", "--lev", "16"};
+    std::vector<char*> trie_argv = make_argv(trie_line);
+    ArgsParser::ParseOptions trie_options;
+    trie_options.allow_abbreviations = true;
+    trie_options.reject_unknown = true;
+    ArgsParser::CompiledSchema trie_schema = trieParser.compile();
+    ArgsParser::ParseResult trie_result = trie_schema.parse((int)trie_line.size(), trie_argv.data(), trie_options);
+    std::vector<std::string> trie_bad_line = {"tool", "--verison"};
+    std::vector<char*> trie_bad_argv = make_argv(trie_bad_line);
+    std::string trie_error;
+    try {
+        trie_schema.parse((int)trie_bad_line.size(), trie_bad_argv.data(), trie_options);
+    }
+    catch (const std::runtime_error& e) {
+        trie_error = e.what();
+    }
+    std::cout << "TRIE_TEST: " << (trieParser.matchIdentifier("--verb") == trieParser.isRegistered("verbose")) << " "
+              << (bool)trieParser.matchIdentifier("--ver") << " " << (trieParser.matchIdentifier("--lev") == trie_level) << " "
+              << (bool)trieParser.matchIdentifier("-v") << " " << trie_suggestions.size() << " " << trie_suggestions[0] << " "
+              << (bool)trie_result.getValue("verbose") << " " << (std::string)trie_result.getValue("level") << " <"
+              << trie_error << ">" << std::endl;
+
+    // Bundled Argument Test
+    // Bundled short switches, attached short values and long options joined
+    // to their value should be split into the arguments they stand for.
+    ArgsParser::Parser bundleParser;
+    bundleParser.registerSwitch("all", {"a"});
+    bundleParser.registerSwitch("brief", {"b"});
+    bundleParser.registerSwitch("color", {"c", "color"});
+    bundleParser.registerOption("jobs", {"j"});
+    bundleParser.registerOption("level", {"level"});
+    bundleParser.registerOption("output", {"o"});
+    bundleParser.registerSwitch("accent", {"accent"});
+    std::vector<std::string> bundle_line = {"tool", "-abj8", "--level=3", "-o", "out", "-xa"};
+    std::vector<char*> bundle_argv = make_argv(bundle_line);
+    bundleParser.parse((int)bundle_line.size(), bundle_argv.data());
+    std::string bundle_error;
+    try {
+        std::vector<std::string> bad_line = {"tool", "--color=always"};
+        std::vector<char*> bad_argv = make_argv(bad_line);
+        bundleParser.compile().parse((int)bad_line.size(), bad_argv.data());
+    }
+    catch (const std::runtime_error& e) {
+        bundle_error = e.what();
+    }
+    // Single dash arguments are split even when they could abbreviate a
+    // long identifier.
+    ArgsParser::ParseOptions bundle_options;
+    bundle_options.allow_abbreviations = true;
+    std::vector<std::string> abbreviated_line = {"tool", "-ac"};
+    std::vector<char*> abbreviated_argv = make_argv(abbreviated_line);
+    ArgsParser::ParseResult abbreviated_result = bundleParser.compile().parse((int)abbreviated_line.size(), abbreviated_argv.data(), bundle_options);
+    std::cout << "BUNDLE_TEST: " << (bool)bundleParser.getValue("all") << " " << (bool)bundleParser.getValue("brief") << " "
+              << (bool)bundleParser.getValue("color") << " " << (std::string)bundleParser.getValue("jobs") << " "
+              << (std::string)bundleParser.getValue("level") << " " << (std::string)bundleParser.getValue("output") << " <"
+              << bundle_error << "> " << (bool)abbreviated_result.getValue("all") << (bool)abbreviated_result.getValue("color")
+              << (bool)abbreviated_result.getValue("accent") << std::endl;
+
+    // Layered Source Test
+    // Arguments missing from the command line should be read from the
+    // environment, then the configuration file, then their default, and only
+    // once they are read.
+    std::ofstream("layered.ini") << "# Service settings\nhost = config.example\nlevel = 7\nlog.level = debug\n\n[server]\nname = \"edge 1\"\nport = 8080\n";
+    setenv("ARGSPARSER_TEST_HOST", "env.example", 1);
+    int layered_reads = 0;
+    ArgsParser::Parser layeredParser;
+    layeredParser.registerOption<int>("level", {"level"}, "value", "", 1, nullptr, [](std::string input)->int{return std::stoi(input);});
+    layeredParser.registerOption("host", {"host"});
+    layeredParser.registerOption("name", {"name"});
+    layeredParser.registerOption<int>("port", {"port"}, "value", "", 1, [&layered_reads](){layered_reads++;},
+        [](std::string input)->int{return std::stoi(input);});
+    layeredParser.registerOption("mode", {"mode"});
+    layeredParser.registerOption("user", {"user"});
+    layeredParser.setConfigKey("level", "level");
+    layeredParser.setEnvironment("host", "ARGSPARSER_TEST_HOST");
+    layeredParser.setConfigKey("host", "host");
+    layeredParser.setConfigKey("name", "server.name");
+    layeredParser.setConfigKey("port", "server.port");
+    layeredParser.setDefault("mode", "fast");
+    layeredParser.setConfigKey("user", "user");
+    layeredParser.registerOption("log", {"log"});
+    layeredParser.setConfigKey("log", "log.level");
+    std::vector<std::string> layered_line = {"tool", "--level", "16"};
+    std::vector<char*> layered_argv = make_argv(layered_line);
+    ArgsParser::ParseOptions layered_options;
+    layered_options.config_file = "layered.ini";
+    ArgsParser::ParseResult layered_result = layeredParser.compile().parse((int)layered_line.size(), layered_argv.data(), layered_options);
+    int layered_reads_before = layered_reads;
+    int layered_port = layered_result.getValue<int>("port");
+    std::cout << "LAYERED_TEST: " << (int)layered_result.getValue<int>("level") << " " << (std::string)layered_result.getValue("host") << " "
+              << (std::string)layered_result.getValue("name") << " " << layered_port << " " << (std::string)layered_result.getValue("mode") << " "
+              << layered_result.isActive(layeredParser.isRegistered("user")) << " " << layered_reads_before << " " << layered_reads << " "
+              << (std::string)layered_result.getValue("log") << std::endl;
+
+    // Fallback Callback Test
+    // Callbacks of arguments read from their other sources should be able to
+    // read other such arguments, and an exception thrown by one should reject
+    // the value instead of escaping the read.
+    ArgsParser::Parser fallbackParser;
+    std::string fallback_inner;
+    std::string fallback_error;
+    fallbackParser.registerOption("outer", {"outer"}, "value", "", 1, [&fallbackParser, &fallback_inner](){
+        fallback_inner = (std::string)fallbackParser.getValue("inner");
+    });
+    fallbackParser.registerOption("inner", {"inner"});
+    fallbackParser.registerOption("broken", {"broken"}, "value", "", 1, [](){ throw std::runtime_error("Callback failed."); }, nullptr,
+        [&fallback_error](const std::exception& e){ fallback_error = e.what(); });
+    fallbackParser.setDefault("outer", "1");
+    fallbackParser.setDefault("inner", "2");
+    fallbackParser.setDefault("broken", "3");
+    std::vector<std::string> fallback_line = {"tool"};
+    std::vector<char*> fallback_argv = make_argv(fallback_line);
+    fallbackParser.parse((int)fallback_line.size(), fallback_argv.data());
+    std::string fallback_outer = fallbackParser.getValue("outer");
+    std::string fallback_broken = fallbackParser.getValue("broken");
+    std::cout << "FALLBACK_CALLBACK_TEST: " << fallback_outer << " " << fallback_inner << " " << fallback_broken
+              << " <" << fallback_error << ">" << std::endl;
+
+    // Instrumentation Test
+    // Builds with instrumentation should count lookups and time the functions
+    // of every argument found, and other builds should record nothing.
+    ArgsParser::Parser statsParser;
+    statsParser.registerSwitch("verbose", {"v", "verbose"});
+    statsParser.registerOption<int>("jobs", {"jobs"}, "count", "", 1, nullptr, [](std::string input)->int{return std::stoi(input);},
+        [](int input){return input > 0;});
+    std::vector<std::string> stats_line = {"tool", "--verbose", "--jobs", "16", "--unknown"};
+    std::vector<char*> stats_argv = make_argv(stats_line);
+    statsParser.parse((int)stats_line.size(), stats_argv.data());
+    ArgsParser::ParseStatistics statistics = statsParser.getStatistics();
+    bool statistics_consistent = statistics.collected?
+        statistics.tokens == 4 && statistics.lookup_hits == 2 && statistics.lookup_misses == 1 && statistics.allocations > 0 &&
+        statistics.arguments.size() == 2 && statistics.arguments[1].name == "jobs" && statistics.arguments[1].converter_ns > 0 &&
+        statistics.scan_ns >= statistics.lookup_ns :
+        statistics.tokens == 0 && statistics.allocations == 0 && statistics.arguments.empty();
+    std::cout << "INSTRUMENTATION_TEST: " << (statistics_consistent ? "consistent" : "inconsistent") << std::endl;
+
+    // Parallel Post-Processing Test
+    // Parsing on a pool should convert and validate the same values as a
+    // sequential parse, keeping those before the first rejected value, while
+    // callbacks are still called from the parsing thread in command line order.
+    ArgsParser::Parser parallelParser;
+    std::string parallel_order;
+    std::string parallel_error;
+    bool parallel_same_thread = true;
+    const std::thread::id parallel_thread = std::this_thread::get_id();
+    auto parallel_record = [&](const std::string& name){
+        return [&parallel_order, &parallel_same_thread, parallel_thread, name](){
+            parallel_order += name + ",";
+            parallel_same_thread = parallel_same_thread && std::this_thread::get_id() == parallel_thread;
+        };
+    };
+    parallelParser.registerSwitch("all", {"a"}, "", parallel_record("all"));
+    parallelParser.registerOption("name", {"--name"}, "name", "", 1, parallel_record("name"),
+        [](const std::string& input){ return !input.empty(); });
+    parallelParser.registerOption<int>("ids", {"--ids"}, "id", "", 5000, parallel_record("ids"),
+        [](std::string input)->int{ return std::stoi(input); },
+        [](const int& id){ return id > 0 && id < 5000? ArgsParser::Status() : ArgsParser::Failure("Identifier " + std::to_string(id) + " is out of range."); },
+        [&parallel_error](const std::exception& e){ parallel_error = e.what(); }
+    );
+    ArgsParser::CompiledSchema parallel_schema = parallelParser.compile();
+    ArgsParser::ThreadPool parallel_pool(4);
+    ArgsParser::ParseOptions parallel_options;
+    parallel_options.pool = &parallel_pool;
+    parallel_options.part_size = 64;
+    std::vector<std::string> parallel_line = {"tool", "--name", "alpha", "--ids"};
+    for (int i = 10; i < 3010; i++) parallel_line.push_back(std::to_string(i));
+    parallel_line.push_back("-a");
+    std::vector<char*> parallel_argv = make_argv(parallel_line);
+    ArgsParser::ParseResult parallel_result = parallel_schema.parse((int)parallel_line.size(), parallel_argv.data(), parallel_options);
+    std::string parallel_callbacks = parallel_order;
+    ArgsParser::ParseResult sequential_result = parallel_schema.parse((int)parallel_line.size(), parallel_argv.data());
+    ArgsParser::Span<int> parallel_ids = parallel_result.getValueView<int>("ids");
+    ArgsParser::Span<int> sequential_ids = sequential_result.getValueView<int>("ids");
+    bool parallel_same = parallel_ids.size() == sequential_ids.size() && std::equal(parallel_ids.begin(), parallel_ids.end(), sequential_ids.begin());
+    std::cout << "PARALLEL_TEST: " << parallel_callbacks << " " << parallel_same_thread << " " << parallel_ids.size() << " "
+              << (parallel_same ? "same" : "different");
+
+    parallel_line[4 + 1499] = "00";
+    parallel_line[4 + 2500] = "9999";
+    parallel_argv = make_argv(parallel_line);
+    parallel_result = parallel_schema.parse((int)parallel_line.size(), parallel_argv.data(), parallel_options);
+    std::string parallel_reason = parallel_error;
+    sequential_result = parallel_schema.parse((int)parallel_line.size(), parallel_argv.data());
+    parallel_ids = parallel_result.getValueView<int>("ids");
+    sequential_ids = sequential_result.getValueView<int>("ids");
+    parallel_same = parallel_ids.size() == sequential_ids.size() && std::equal(parallel_ids.begin(), parallel_ids.end(), sequential_ids.begin()) &&
+        parallel_reason == parallel_error;
+    std::cout << " " << parallel_ids.size() << " <" << parallel_reason << "> " << (parallel_same ? "same" : "different") << std::endl;
+
+    // A batch parsed on the pool given to each parse should process the
+    // arguments of each line on its own thread rather than wait on the pool.
+    // The lines are parsed concurrently, so the schema has no callbacks.
+    ArgsParser::Parser nestedParser;
+    nestedParser.registerOption("name", {"--name"});
+    nestedParser.registerOption<int>("ids", {"--ids"}, "id", "", 5000, nullptr, [](std::string input)->int{ return std::stoi(input); });
+    std::vector<std::vector<std::string>> nested_lines(8, std::vector<std::string>(parallel_line.begin(), parallel_line.begin() + 1000));
+    std::vector<ArgsParser::BatchResult> nested_batch = ArgsParser::parseBatch(nestedParser.compile(), nested_lines, parallel_pool, parallel_options);
+    size_t nested_values = 0;
+    for (size_t i = 0; i < nested_batch.size(); i++) nested_values += nested_batch[i].result.getValueView<int>("ids").size();
+    std::cout << "NESTED_POOL_TEST: " << nested_batch.size() << " " << nested_values << std::endl;
+
+    // Asynchronous Validator Test
+    // Validators returning futures should all be started before any is
+    // awaited, and failures should reach the error handlers in command line
+    // order, keeping the values before the first rejected one.
+    ArgsParser::Parser asyncParser;
+    std::atomic<int> async_started(0);
+    std::atomic<int> async_overlapped(0);
+    std::string async_order;
+    const int async_count = 6;
+    auto async_wait = [&async_started, &async_overlapped, async_count](){
+        // Every validation waits for the others to start, which only happens
+        // if none of them is awaited first.
+        async_started++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (async_started < async_count && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (async_started == async_count) async_overlapped++;
+    };
+    asyncParser.registerOption<int>("ports", {"--ports"}, "port", "", 8, [&async_order](){ async_order += "ports,"; },
+        [](std::string input)->int{ return std::stoi(input); },
+        [async_wait](const int& port){
+            return std::async(std::launch::async, [async_wait, port]() -> ArgsParser::Status {
+                async_wait();
+                if (port == 0) return ArgsParser::Failure("Port " + std::to_string(port) + " is in use.");
+                return ArgsParser::Status();
+            });
+        },
+        [&async_order](const std::exception& e){ async_order += std::string("<") + e.what() + ">,"; }
+    );
+    asyncParser.registerOption("paths", {"--paths"}, "path", "", 8, [&async_order](){ async_order += "paths,"; },
+        [async_wait](const std::string& path){
+            return std::async(std::launch::async, [async_wait, &path](){
+                async_wait();
+                if (path == "missing") throw std::runtime_error("No file \"" + path + "\".");
+                return true;
+            });
+        },
+        [&async_order](const std::exception& e){ async_order += std::string("<") + e.what() + ">,"; }
+    );
+    asyncParser.registerSwitch("verbose", {"-v"}, "", [&async_order](){ async_order += "verbose,"; });
+    std::vector<std::string> async_line = {"tool", "--paths", "here", "there", "missing", "--ports", "8080", "8081", "00", "-v"};
+    std::vector<char*> async_argv = make_argv(async_line);
+    ArgsParser::ParseResult async_result = asyncParser.compile().parse((int)async_line.size(), async_argv.data());
+    ArgsParser::Span<int> async_ports = async_result.getValueView<int>("ports");
+    std::cout << "ASYNC_TEST: " << async_overlapped << " " << async_order << " " << async_ports.size() << " "
+              << (async_ports.size() == 2 && async_ports[1] == 8081 ? "kept" : "lost") << std::endl;
+
     std::cout << "Debug";
 
     return 0;